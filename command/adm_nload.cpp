@@ -42,7 +42,7 @@ const void AdmNload::Run( Character* character, const string& cmd, const string&
         }
 
         chr = new Character();
-        if ( !chr->Clone( arg, HANDLER_FIND_ID ) )
+        if ( !chr->Clone( arg, HANDLER_FIND_ID_PREFIX ) )
         {
             character->Send( "Unable to find that NPC." CRLF );
             delete chr;
@@ -42,7 +42,7 @@ const void AdmOload::Run( Character* character, const string& cmd, const string&
         }
 
         obj = new Object();
-        if ( !obj->Clone( arg, HANDLER_FIND_ID ) )
+        if ( !obj->Clone( arg, HANDLER_FIND_ID_PREFIX ) )
         {
             character->Send( "Unable to find that object." CRLF );
             delete obj;
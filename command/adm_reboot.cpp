@@ -19,6 +19,7 @@
 #include "pincludes.h"
 
 #include "account.h"
+#include "iothread.h"
 #include "list.h"
 #include "server.h"
 #include "socketserver.h"
@@ -35,20 +36,27 @@ class AdmReboot : public Plugin {
 const void AdmReboot::Run( Character* character, const string& cmd, const string& arg ) const
 {
     SocketClient* socket_client = NULL;
-    ITER( vector, SocketClient*, si );
+    size_t i = 0;
     string desc, port;
     ofstream ofs;
 
     Utils::FileOpen( ofs, CFG_DAT_FILE_REBOOT );
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
+    for ( i = 0; i < socket_client_list.Length(); i++ )
     {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
+        if ( ( socket_client = socket_client_list.At( i ) ) == NULL )
+            continue;
 
         if ( arg == "silent" )
             ofs << "slnt = silent" << endl;
         else
             ofs << "slnt = " << endl;
+        // The new process can't continue a compression stream, so end it cleanly
+        if ( socket_client->gTermInfo()->gNegotiated( SOC_TELOPT_COMPRESS2 ) )
+        {
+            Telopt::Negotiate( socket_client, SOC_TELOPT_COMPRESS2, false );
+            socket_client->Send();
+        }
+        socket_client->sCloseOnExec( false );
         ofs << "desc = " << socket_client->gDescriptor() << endl;
         ofs << "port = " << socket_client->gPort() << endl;
         ofs << "host = " << socket_client->gHostname() << endl;
@@ -69,11 +77,21 @@ const void AdmReboot::Run( Character* character, const string& cmd, const string
     }
     Utils::FileClose( ofs );
 
+    // Stopping the I/O threads writes out everything handed to them first
+    while ( !g_global->m_io_threads.empty() )
+    {
+        g_global->m_io_threads.back()->Delete();
+        g_global->m_io_threads.pop_back();
+    }
+
     port = Utils::String( g_global->m_listen->gPort() );
     desc = Utils::String( g_global->m_listen->gDescriptor() );
 
     execl( "src/nams", "nams", CSTR( port ), CSTR( desc ), (char*)NULL );
-    LOGERRNO( 0, "" );
+
+    // The I/O threads are gone and every client has been handed over, so the old process can't carry on
+    LOGERRNO( 0, "AdmReboot::Run()->execl()->" );
+    ::exit( EXIT_FAILURE );
 
     return;
 }
@@ -29,26 +29,20 @@ class Inventory : public Plugin {
 
 const void Inventory::Run( Character* character, const string& cmd, const string& arg ) const
 {
-    ITER( vector, Thing*, vi );
-    vector<Thing*> contents;
     Thing* item = NULL;
 
     if ( character )
     {
-        contents = character->gContents();
         character->Send( "You are carrying:" CRLF );
 
-        if ( contents.empty() )
+        if ( character->gContentCount() == 0 )
         {
             character->Send( "    Nothing." CRLF );
             return;
         }
 
-        for ( vi = contents.begin(); vi != contents.end(); vi++ )
-        {
-            item = *vi;
+        for ( item = character->gFirstContent(); item != NULL; item = item->gNextContent() )
             character->Send( "    " + item->gDescription( THING_DESCRIPTION_SHORT ) + CRLF );
-        }
     }
 
     return;
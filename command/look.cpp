@@ -34,11 +34,8 @@ class Look : public Plugin {
 const void Look::Run( Character* character, const string& cmd, const string& arg ) const
 {
     Location* location = NULL;
-    vector<Exit*> exits;
     CITER( vector, Exit*, ei );
     Exit* exit = NULL;
-    vector<Thing*> contents;
-    CITER( vector, Thing*, ci );
     Thing* content = NULL;
     Thing* target = NULL;
     string args, sobj, star;
@@ -52,15 +49,13 @@ const void Look::Run( Character* character, const string& cmd, const string& arg
 
         if ( arg.empty() && location != NULL ) // no args, display the room
         {
-            exits = location->gExits();
-
             character->Send( "[Exits:");
 
-            if ( exits.empty() )
+            if ( location->gExits().empty() )
                 character->Send( " none]" CRLF );
             else
             {
-                for ( ei = exits.begin(); ei != exits.end(); ei++ )
+                for ( ei = location->gExits().begin(); ei != location->gExits().end(); ei++ )
                 {
                     exit = *ei;
                     character->Send( " " + exit->gName() );
@@ -73,18 +68,14 @@ const void Look::Run( Character* character, const string& cmd, const string& arg
             character->Send( location->gDescription( THING_DESCRIPTION_LONG ) + CRLF );
 
             //Contents
-            contents = location->gContents();
-
-            if ( !contents.empty() )
+            if ( location->gContentCount() > 0 )
             {
                 // We are not alone
-                if ( contents.size() > 1 )
+                if ( location->gContentCount() > 1 )
                     character->Send( CRLF );
 
-                for ( ci = contents.begin(); ci != contents.end(); ci++ )
+                for ( content = location->gFirstContent(); content != NULL; content = content->gNextContent() )
                 {
-                    content = *ci;
-
                     if ( content == character )
                         continue;
                     else
@@ -131,19 +122,14 @@ const void Look::Run( Character* character, const string& cmd, const string& arg
             }
 
             character->Send( target->gDescription( THING_DESCRIPTION_SHORT ) + " contains:" CRLF );
-            contents = target->gContents();
-
-            if ( contents.empty() )
+            if ( target->gContentCount() == 0 )
             {
                 character->Send( "    Nothing." CRLF );
                 return;
             }
 
-            for ( ci = contents.begin(); ci != contents.end(); ci++ )
-            {
-                content = *ci;
+            for ( content = target->gFirstContent(); content != NULL; content = content->gNextContent() )
                 character->Send( "    " + content->gDescription( THING_DESCRIPTION_SHORT ) + CRLF );
-            }
         }
         else if ( ( Utils::String( "self" ).find( arg ) == 0 ) || ( ( target = Handler::FindThing( arg, THING_TYPE_CHARACTER, HANDLER_SCOPE_LOCATION, character, true ) ) != NULL ) )
         {
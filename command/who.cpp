@@ -32,16 +32,16 @@ class Who : public Plugin {
 
 const void Who::Run( Character* character, const string& cmd, const string& arg ) const
 {
-    CITER( vector, SocketClient*, si );
     SocketClient* target = NULL;
+    size_t i = 0;
 
     if ( character )
     {
         character->Send( CFG_STR_VERSION CRLF );
-        for ( si = socket_client_list.begin(); si != socket_client_list.end(); si++ )
+        for ( i = 0; i < socket_client_list.Length(); i++ )
         {
-            target = *si;
-
+            if ( ( target = socket_client_list.At( i ) ) == NULL )
+                continue;
             if ( target->gAccount() == NULL )
                 continue;
             if ( target->gAccount()->gCharacter() == NULL )
@@ -0,0 +1,170 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file atomtable.cpp
+ * @brief All non-template member functions of the AtomTable class.
+ *
+ * A Thing holds its name, zone and location as an Atom rather than a
+ * string of its own. Every Object cloned from a template therefore shares
+ * one copy of each, comparing two of them is an integer comparison, and
+ * the case folded form used by searches is worked out once when a string
+ * is first interned instead of on every search. Atoms are never released;
+ * the table only holds strings loaded from disk or chosen by players.
+ */
+#include "h/includes.h"
+#include "h/atomtable.h"
+
+/* Core */
+/**
+ * @brief Unload the AtomTable from memory.
+ * @retval void
+ */
+const void AtomTable::Delete()
+{
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Looks up the Atom of a string without interning it.
+ * @param[in] text The string to search for.
+ * @retval Atom The Atom of text, or #ATOM_NONE if text has never been interned.
+ */
+const Atom AtomTable::Find( const string& text ) const
+{
+    unordered_map<string,Atom>::const_iterator ai;
+
+    if ( ( ai = m_atoms.find( text ) ) == m_atoms.end() )
+        return ATOM_NONE;
+
+    return ai->second;
+}
+
+/**
+ * @brief Returns the Atom of a string, adding the string to the table if it is new.
+ * @param[in] text The string to be interned.
+ * @retval Atom The Atom which refers to text. The empty string is always #ATOM_EMPTY.
+ */
+const Atom AtomTable::Intern( const string& text )
+{
+    pair<unordered_map<string,Atom>::iterator,bool> inserted;
+    AtomTable::Entry entry;
+    Atom atom = m_entries.size(), folded_atom = ATOM_EMPTY;
+    string folded;
+
+    inserted = m_atoms.insert( pair<string,Atom>( text, atom ) );
+
+    if ( !inserted.second )
+        return inserted.first->second;
+
+    entry.m_folded = atom;
+    entry.m_text = &inserted.first->first;
+    m_entries.push_back( entry );
+
+    // Intern the folded form as well so that searches never need to fold again. Interning may grow m_entries, so the
+    // entry is only looked up again afterwards
+    if ( CFG_GAM_CMD_IGNORE_CASE && ( folded = Utils::Lower( text ) ) != text )
+    {
+        folded_atom = Intern( folded );
+        m_entries[atom].m_folded = folded_atom;
+    }
+
+    return atom;
+}
+
+/**
+ * @brief Prepare the table for use.
+ * @retval false Returned if the table was unable to be prepared.
+ * @retval true Returned if the table is ready to intern strings.
+ */
+const bool AtomTable::New()
+{
+    if ( Intern( "" ) != ATOM_EMPTY )
+        return false;
+
+    return true;
+}
+
+/* Query */
+/**
+ * @brief Returns the Atom of a string folded to lowercase if #CFG_GAM_CMD_IGNORE_CASE is set.
+ * @param[in] atom The Atom of the string.
+ * @retval Atom The Atom of the folded string.
+ */
+const Atom AtomTable::gFolded( const Atom& atom ) const
+{
+    if ( atom >= m_entries.size() )
+        return ATOM_EMPTY;
+
+    return m_entries[atom].m_folded;
+}
+
+/**
+ * @brief Returns the text of a string folded to lowercase if #CFG_GAM_CMD_IGNORE_CASE is set.
+ * @param[in] atom The Atom of the string.
+ * @retval string The folded text, which stays valid for the life of the table.
+ */
+const string& AtomTable::gFoldedText( const Atom& atom ) const
+{
+    return gText( gFolded( atom ) );
+}
+
+/**
+ * @brief Returns the number of strings within the table.
+ * @retval uint_t The number of interned strings.
+ */
+const uint_t AtomTable::gSize() const
+{
+    return m_entries.size();
+}
+
+/**
+ * @brief Returns the text of an Atom.
+ * @param[in] atom The Atom of the string.
+ * @retval string The text, which stays valid for the life of the table. Unknown atoms return the empty string.
+ */
+const string& AtomTable::gText( const Atom& atom ) const
+{
+    if ( atom >= m_entries.size() )
+        return *m_entries[ATOM_EMPTY].m_text;
+
+    return *m_entries[atom].m_text;
+}
+
+/* Manipulate */
+
+/* Internal */
+/**
+ * @brief Constructor for the AtomTable class.
+ */
+AtomTable::AtomTable()
+{
+    m_atoms.clear();
+    m_entries.clear();
+
+    return;
+}
+
+/**
+ * @brief Destructor for the AtomTable class.
+ */
+AtomTable::~AtomTable()
+{
+    return;
+}
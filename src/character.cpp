@@ -28,6 +28,7 @@
 #include "h/account.h"
 #include "h/brain.h"
 #include "h/command.h"
+#include "h/event.h"
 #include "h/list.h"
 #include "h/location.h"
 #include "h/socketclient.h"
@@ -66,17 +67,18 @@ const bool Character::Clone( const string& name, const uint_t& type )
     /** Copy elements from Thing parent class */
     for ( search = 0; search < MAX_THING_DESCRIPTION; search++ )
         sDescription( chr->gDescription( search ), search );
-    sName( chr->gName() );
-    sZone( chr->gZone() );
+    sName( chr->gNameAtom() );
+    sZone( chr->gZoneAtom() );
     /** Copy elements internal to Character class */
     for ( search = 0; search < MAX_CHR_CREATION; search++ )
         sCreation( chr->gCreation( search ), search );
     m_file = chr->m_file;
     m_sex = chr->m_sex;
-    /** Generate a unique id based on obj_list.size() and current time */
-    NewId( character_list.size() );
+    /** Generate a unique id */
+    NewId();
 
-    character_list.push_back( this );
+    m_list_handle = character_list.Add( this );
+    Index( &character_index );
 
     return true;
 }
@@ -87,12 +89,20 @@ const bool Character::Clone( const string& name, const uint_t& type )
  */
 const void Character::Delete()
 {
-    if ( find( character_list.begin(), character_list.end(), this ) != character_list.end() )
-        g_global->m_next_character = character_list.erase( find( character_list.begin(), character_list.end(), this ) );
+    // Nothing may run on behalf of a Character that no longer exists
+    Event::Cancel( &m_events );
+
+    if ( m_list_handle != 0 )
+        character_list.Remove( m_list_handle );
     else if ( find( character_template_list.begin(), character_template_list.end(), this ) != character_template_list.end() )
             character_template_list.erase( find( character_template_list.begin(), character_template_list.end(), this ) );
 
-    delete this;
+    Unindex();
+    if ( !g_global->m_shutdown && gContainer() != NULL )
+        gContainer()->RemoveThing( this );
+
+    // A loop further up the stack may still hold this pointer, so the memory is only released by Server::FreeDeleted()
+    character_delete_list.push_back( this );
 
     return;
 }
@@ -106,10 +116,24 @@ const void Character::Delete()
  */
 const void Character::Interpret( const uint_t& security, const string& cmd, const string& args )
 {
-    Command* command = NULL;
+    Interpret( security, cmd, args, Handler::FindCommand( cmd ) );
+
+    return;
+}
+
+/**
+ * @brief Interprets cmd with args at level security, where cmd has already been resolved to a Command.
+ * @param[in] security Security level which is inherited from the Account, if any. Values from #ACT_SECURITY.
+ * @param[in] cmd The command as received, used to search for an exit if it is not a Command.
+ * @param[in] args Arguments to be passed to the command.
+ * @param[in] command The Command that cmd resolved to, or NULL if it did not match one.
+ * @retval void
+ */
+const void Character::Interpret( const uint_t& security, const string& cmd, const string& args, Command* command )
+{
     Exit* exit = NULL;
 
-    if ( ( command = Handler::FindCommand( cmd ) ) != NULL )
+    if ( command != NULL )
     {
         if ( command->Authorized( security ) )
             command->Run( this, cmd, args );
@@ -157,9 +181,15 @@ const bool Character::New( const string& file, const bool& itemplate, const bool
     }
 
     if ( itemplate )
+    {
         character_template_list.push_back( this );
+        Index( &character_template_index );
+    }
     else
-        character_list.push_back( this );
+    {
+        m_list_handle = character_list.Add( this );
+        Index( &character_index );
+    }
 
     return true;
 }
@@ -180,6 +210,22 @@ const void Character::Send( const string& msg, Thing* speaker, Thing* target ) c
     return;
 }
 
+/**
+ * @brief Send a shared segment to the associated SocketClient, if any.
+ * @param[in] msg The segment to be sent.
+ * @param[in] speaker The Thing originating the message.
+ * @param[in] target The Thing who is the target of the message.
+ * @retval void
+ */
+const void Character::Send( const Segment& msg, Thing* speaker, Thing* target ) const
+{
+    if ( gBrain()->gAccount() )
+        if ( gBrain()->gAccount()->gClient() )
+            gBrain()->gAccount()->gClient()->Send( msg );
+
+    return;
+}
+
 /**
  * @brief Serialize the character data.
  * @retval false Returned if there was an error serializing the character.
@@ -335,6 +381,15 @@ const bool Character::gCreation( const uint_t& pos )
     return m_creation[pos];
 }
 
+/**
+ * @brief Returns the pending events initiated by the character. Used by Event to add and remove itself.
+ * @retval list<Event*>* A pointer to the list of pending events.
+ */
+list<Event*>* Character::gEvents()
+{
+    return &m_events;
+}
+
 /**
  * @brief Generates a status-bar prompt based on tokens.
  * @retval string A string containing the status information.
@@ -414,7 +469,9 @@ Character::Character()
     /** Initialize attributes specific to Characters */
     for ( i = 0; i < MAX_CHR_CREATION; i++ )
         m_creation[i] = false;
+    m_events.clear();
     m_file.clear();
+    m_list_handle = 0;
     m_sex = 0;
 
     return;
@@ -33,6 +33,7 @@
 
 #include "h/brain.h"
 #include "h/character.h"
+#include "h/event.h"
 #include "h/list.h"
 #include "h/plugin.h"
 #include "h/socketclient.h"
@@ -62,6 +63,10 @@ const bool Command::Authorized( const uint_t& sec ) const
 const void Command::Delete()
 {
     UFLAGS_DE( flags );
+    vector< pair<string,Command*> >::iterator ci;
+
+    // Pending events would otherwise be left pointing at an unloaded plugin
+    Event::Cancel( &m_events );
 
     m_plg_delete( m_plg );
     ::dlerror();
@@ -72,6 +77,17 @@ const void Command::Delete()
     if ( find( command_list.begin(), command_list.end(), this ) != command_list.end() )
         command_list.erase( find( command_list.begin(), command_list.end(), this ) );
 
+    for ( ci = command_index.begin(); ci != command_index.end(); ci++ )
+    {
+        if ( ci->second == this )
+        {
+            command_index.erase( ci );
+            break;
+        }
+    }
+
+    g_global->m_command_revision++;
+
     delete this;
 
    return;
@@ -86,7 +102,7 @@ const void Command::Delete()
 const bool Command::New( const string& file )
 {
     UFLAGS_DE( flags );
-    string path( Utils::DirPath( CFG_DAT_DIR_OBJ, file, CFG_PLG_BUILD_EXT_OUT ) );
+    string key, path( Utils::DirPath( CFG_DAT_DIR_OBJ, file, CFG_PLG_BUILD_EXT_OUT ) );
     vector<string> disabled = g_config->gDisabledCommands();
 
     // Ensure there is a valid file to open
@@ -120,6 +136,9 @@ const bool Command::New( const string& file )
     }
 
     command_list.push_back( this );
+    key = CFG_GAM_CMD_IGNORE_CASE ? Utils::Lower( gName() ) : gName();
+    command_index.insert( lower_bound( command_index.begin(), command_index.end(), pair<string,Command*>( key, this ) ), pair<string,Command*>( key, this ) );
+    g_global->m_command_revision++;
 
     return true;
 }
@@ -174,6 +193,15 @@ void* Command::gCaller() const
     return m_plg->gCaller();
 }
 
+/**
+ * @brief Returns the pending events which will execute the command. Used by Event to add and remove itself.
+ * @retval list<Event*>* A pointer to the list of pending events.
+ */
+list<Event*>* Command::gEvents()
+{
+    return &m_events;
+}
+
 /**
  * @brief Return the filename of the associated Plugin object.
  * @retval string A string containing the filename of the associated Plugin object.
@@ -221,6 +249,7 @@ const void Command::ToggleDisable()
 Command::Command()
 {
     m_disabled = false;
+    m_events.clear();
     m_plg = NULL;
     m_plg_delete = NULL;
     m_plg_file.clear();
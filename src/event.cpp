@@ -24,18 +24,48 @@
 #include "h/includes.h"
 #include "h/event.h"
 
+#include "h/character.h"
 #include "h/command.h"
-#include "h/list.h"
+#include "h/eventwheel.h"
+#include "h/pool.h"
+#include "h/socketclient.h"
 
 /* Core */
+/**
+ * @brief Cancel and unload pending events, such as those of an owner that is about to be deleted.
+ * @param[in] events The pending events of a Character, Command, or SocketClient.
+ * @param[in] command If not NULL, only events which would execute this Command are cancelled.
+ * @retval void
+ */
+const void Event::Cancel( list<Event*>* events, const Command* command )
+{
+    ITER( list, Event*, ei );
+    Event* event = NULL;
+
+    if ( events == NULL )
+        return;
+
+    for ( ei = events->begin(); ei != events->end(); )
+    {
+        event = *ei++;
+
+        if ( command == NULL || event->gCommand() == command )
+            event->Delete();
+    }
+
+    return;
+}
+
 /**
  * @brief Unload an event from memory that was previously loaded via Event::New().
  * @retval void
  */
 const void Event::Delete()
 {
-    if ( find( event_list.begin(), event_list.end(), this ) != event_list.end() )
-         g_global->m_next_event = event_list.erase( find( event_list.begin(), event_list.end(), this ) );
+    Unlink();
+
+    if ( m_slot != NULL )
+        g_global->m_event_wheel->Remove( this );
 
     delete this;
 
@@ -49,7 +79,7 @@ const void Event::Delete()
  * @param[in] character The character who initiated the function.
  * @param[in] command The command to execute.
  * @param[in] type The type of Event.
- * @param[in] time How long to wait before executing Event::Run().
+ * @param[in] time How many pulses to wait before executing Event::Run(). A time of zero runs on the next pulse.
  * @retval false Returned if the event is unable to be created.
  * @retval true Returned if the event was successfully created.
  */
@@ -85,10 +115,16 @@ const bool Event::New( const string& cmd, const string& args, Character* charact
     m_cmd = cmd;
     m_character = character;
     m_command = command;
-    m_time = time;
+    m_expires = g_global->m_pulse + max( time, static_cast<uint_t>( 1 ) );
     m_type = type;
 
-    event_list.push_back( this );
+    if ( !g_global->m_event_wheel->Add( this ) )
+    {
+        LOGSTR( flags, "Event::New()->EventWheel::Add()-> returned false" );
+        return false;
+    }
+
+    Link();
 
     return true;
 }
@@ -97,7 +133,7 @@ const bool Event::New( const string& cmd, const string& args, Character* charact
  * @brief Create a new Event. This is a special use-case to create an Event for things such as Server::ReloadCommand.
  * @param[in] args The arguments to be passed to the function.
  * @param[in] type The type of Event.
- * @param[in] time How long to wait before executing Event::Run().
+ * @param[in] time How many pulses to wait before executing Event::Run(). A time of zero runs on the next pulse.
  * @retval false Returned if the event is unable to be created.
  * @retval true Returned if the event was successfully created.
  */
@@ -124,10 +160,16 @@ const bool Event::New( const string& args, const uint_t& type, const uint_t& tim
     }
 
     m_args = args;
-    m_time = time;
+    m_expires = g_global->m_pulse + max( time, static_cast<uint_t>( 1 ) );
     m_type = type;
 
-    event_list.push_back( this );
+    if ( !g_global->m_event_wheel->Add( this ) )
+    {
+        LOGSTR( flags, "Event::New()->EventWheel::Add()-> returned false" );
+        return false;
+    }
+
+    Link();
 
     return true;
 }
@@ -139,7 +181,7 @@ const bool Event::New( const string& args, const uint_t& type, const uint_t& tim
  * @param[in] client The client who initiated the function.
  * @param[in] command The command to execute.
  * @param[in] type The type of Event.
- * @param[in] time How long to wait before executing Event::Run().
+ * @param[in] time How many pulses to wait before executing Event::Run(). A time of zero runs on the next pulse.
  * @retval false Returned if the event is unable to be created.
  * @retval true Returned if the event was successfully created.
  */
@@ -175,10 +217,16 @@ const bool Event::New( const string& cmd, const string& args, SocketClient* clie
     m_cmd = cmd;
     m_client = client;
     m_command = command;
-    m_time = time;
+    m_expires = g_global->m_pulse + max( time, static_cast<uint_t>( 1 ) );
     m_type = type;
 
-    event_list.push_back( this );
+    if ( !g_global->m_event_wheel->Add( this ) )
+    {
+        LOGSTR( flags, "Event::New()->EventWheel::Add()-> returned false" );
+        return false;
+    }
+
+    Link();
 
     return true;
 }
@@ -189,6 +237,9 @@ const bool Event::New( const string& cmd, const string& args, SocketClient* clie
  */
 const void Event::Run()
 {
+    // Running the Event may delete its owners, which would otherwise cancel it mid-run
+    Unlink();
+
     switch ( m_type )
     {
         case EVENT_TYPE_RELOAD:
@@ -212,19 +263,6 @@ const void Event::Run()
     return;
 }
 
-/**
- * @brief Updates the Event by decrementing the remaining time.
- * @retval false Returned once m_time reaches #uintmin_t and the Event can no longer update.
- * @retval true Returned if m_time is greater than #uintmin_t and the Event can still update.
- */
-const bool Event::Update()
-{
-    if ( --m_time > uintmin_t )
-        return true;
-    else
-        return false;
-}
-
 /* Query */
 /**
  * @brief Returns the Character associated to this Event, if any.
@@ -245,15 +283,79 @@ Command* Event::gCommand() const
 }
 
 /**
- * @brief  Returns the amount of time remaining.
+ * @brief Returns the pulse on which the Event is due to execute.
+ * @retval uint_t The pulse on which the Event is due.
+ */
+const uint_t Event::gExpires() const
+{
+    return m_expires;
+}
+
+/**
+ * @brief Returns the handle which identifies the Event. Unlike a pointer, a handle can be safely held after the Event has run.
+ * @retval SlotHandle The handle of the Event within the EventWheel, or 0 if it is not scheduled.
+ */
+const SlotHandle Event::gHandle() const
+{
+    return m_handle;
+}
+
+/**
+ * @brief Returns the slot of the EventWheel holding the Event.
+ * @retval list<Event*>* A pointer to the slot holding the Event, or NULL if it is not scheduled.
+ */
+list<Event*>* Event::gSlot() const
+{
+    return m_slot;
+}
+
+/**
+ * @brief Returns the position of the Event within its slot of the EventWheel.
+ * @retval list<Event*>::iterator The position of the Event within the slot returned by Event::gSlot().
+ */
+const list<Event*>::iterator Event::gSlotPosition() const
+{
+    return m_slot_pos;
+}
+
+/**
+ * @brief Returns the number of pulses remaining until the Event executes.
  * @retval uint_t The amount of time remaining.
  */
 const uint_t Event::gTime() const
 {
-    return m_time;
+    if ( m_expires > g_global->m_pulse )
+        return m_expires - g_global->m_pulse;
+
+    return uintmin_t;
 }
 
 /* Manipulate */
+/**
+ * @brief Sets the handle of the Event within the EventWheel. Only called by the EventWheel.
+ * @param[in] handle The handle the EventWheel holds the Event under, or 0 once it is no longer scheduled.
+ * @retval void
+ */
+const void Event::sHandle( const SlotHandle& handle )
+{
+    m_handle = handle;
+
+    return;
+}
+
+/**
+ * @brief Record where the EventWheel is holding the Event. Only to be called by the EventWheel.
+ * @param[in] slot The slot holding the Event, or NULL once it is no longer scheduled.
+ * @param[in] pos The position of the Event within slot.
+ * @retval void
+ */
+const void Event::sSlot( list<Event*>* slot, const list<Event*>::iterator& pos )
+{
+    m_slot = slot;
+    m_slot_pos = pos;
+
+    return;
+}
 
 /* Internal */
 /**
@@ -266,7 +368,10 @@ Event::Event()
     m_character = NULL;
     m_client = NULL;
     m_command = NULL;
-    m_time = uintmin_t;
+    m_expires = uintmin_t;
+    m_handle = 0;
+    m_linked = false;
+    m_slot = NULL;
     m_type = uintmin_t;
 
     return;
@@ -279,3 +384,70 @@ Event::~Event()
 {
     return;
 }
+
+/**
+ * @brief Allocate memory for an Event from its Pool.
+ * @param[in] size The size of the object being created.
+ * @retval void* A pointer to the memory.
+ */
+void* Event::operator new( size_t size )
+{
+    return g_global->m_event_pool->Allocate( size );
+}
+
+/**
+ * @brief Return the memory of an Event to its Pool.
+ * @param[in] ptr A pointer to the memory of the deleted object.
+ * @param[in] size The size of the deleted object.
+ * @retval void
+ */
+void Event::operator delete( void* ptr, size_t size )
+{
+    g_global->m_event_pool->Free( ptr, size );
+
+    return;
+}
+
+/**
+ * @brief Add the Event to the pending events of its owning Character or SocketClient and of its Command.
+ * @retval void
+ */
+const void Event::Link()
+{
+    if ( m_linked )
+        return;
+
+    if ( m_character != NULL )
+        m_owner_pos = m_character->gEvents()->insert( m_character->gEvents()->end(), this );
+    else if ( m_client != NULL )
+        m_owner_pos = m_client->gEvents()->insert( m_client->gEvents()->end(), this );
+
+    if ( m_command != NULL )
+        m_command_pos = m_command->gEvents()->insert( m_command->gEvents()->end(), this );
+
+    m_linked = true;
+
+    return;
+}
+
+/**
+ * @brief Remove the Event from the pending events of its owners.
+ * @retval void
+ */
+const void Event::Unlink()
+{
+    if ( !m_linked )
+        return;
+
+    if ( m_character != NULL )
+        m_character->gEvents()->erase( m_owner_pos );
+    else if ( m_client != NULL )
+        m_client->gEvents()->erase( m_owner_pos );
+
+    if ( m_command != NULL )
+        m_command->gEvents()->erase( m_command_pos );
+
+    m_linked = false;
+
+    return;
+}
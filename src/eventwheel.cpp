@@ -0,0 +1,256 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file eventwheel.cpp
+ * @brief All non-template member functions of the EventWheel class.
+ *
+ * Each level of the wheel is a ring of slots, one per pulse at the bottom
+ * level and one per EVENTWHEEL_SLOTS^n pulses at level n. An Event is placed
+ * in the lowest level able to reach it and, every time the level below
+ * wraps, the next slot of the level above is emptied back down the wheel.
+ * Scheduling and cancelling an Event are constant time, and each pulse only
+ * touches the events that are due plus the occasional cascade.
+ */
+#include "h/includes.h"
+#include "h/eventwheel.h"
+
+#include "h/event.h"
+
+/* Core */
+/**
+ * @brief Schedule an Event to be run once the pulse it expires on is reached.
+ * @param[in] event The Event to be scheduled.
+ * @retval false Returned if the Event is NULL or is already scheduled.
+ * @retval true Returned if the Event was scheduled.
+ */
+const bool EventWheel::Add( Event* event )
+{
+    UFLAGS_DE( flags );
+    list<Event*> pending;
+
+    if ( event == NULL )
+    {
+        LOGSTR( flags, "EventWheel::Add()-> called with NULL event" );
+        return false;
+    }
+
+    if ( event->gSlot() != NULL )
+    {
+        LOGSTR( flags, "EventWheel::Add()-> called with an event that is already scheduled" );
+        return false;
+    }
+
+    pending.push_back( event );
+    Insert( event, pending, pending.begin() );
+    event->sHandle( m_handles.Add( event ) );
+
+    return true;
+}
+
+/**
+ * @brief Unload the EventWheel from memory along with any events still pending.
+ * @retval void
+ */
+const void EventWheel::Delete()
+{
+    Event* event = NULL;
+    uint_t level = 0, slot = 0;
+
+    for ( level = 0; level < EVENTWHEEL_LEVELS; level++ )
+    {
+        for ( slot = 0; slot < EVENTWHEEL_SLOTS; slot++ )
+        {
+            while ( !m_slots[level][slot].empty() )
+            {
+                event = m_slots[level][slot].front();
+                Remove( event );
+                event->Delete();
+            }
+        }
+    }
+
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Locate a pending Event by its handle.
+ * @param[in] handle The handle returned by Event::gHandle().
+ * @retval Event* A pointer to the Event, or NULL if it has already run or been cancelled.
+ */
+Event* EventWheel::Find( const SlotHandle& handle ) const
+{
+    return m_handles.Get( handle );
+}
+
+/**
+ * @brief Start the wheel turning from the current pulse.
+ * @retval false Returned if the wheel was unable to be started.
+ * @retval true Returned if the wheel is ready to accept events.
+ */
+const bool EventWheel::New()
+{
+    m_tick = g_global->m_pulse + 1;
+
+    return true;
+}
+
+/**
+ * @brief Cancel a scheduled Event. The Event itself is left in memory.
+ * @param[in] event The Event to be cancelled.
+ * @retval false Returned if the Event is NULL or was not scheduled.
+ * @retval true Returned if the Event was removed from the wheel.
+ */
+const bool EventWheel::Remove( Event* event )
+{
+    if ( event == NULL || event->gSlot() == NULL )
+        return false;
+
+    event->gSlot()->erase( event->gSlotPosition() );
+    event->sSlot( NULL, event->gSlotPosition() );
+    m_handles.Remove( event->gHandle() );
+    event->sHandle( 0 );
+
+    return true;
+}
+
+/**
+ * @brief Advance the wheel to the current pulse, running every Event that has come due.
+ * @retval void
+ */
+const void EventWheel::Update()
+{
+    ITER( list, Event*, ei );
+    list<Event*> due;
+    Event* event = NULL;
+    uint_t index = 0, level = 0;
+
+    while ( m_tick <= g_global->m_pulse )
+    {
+        index = m_tick & ( EVENTWHEEL_SLOTS - 1 );
+
+        // The bottom level has wrapped, so refill it from the levels above
+        if ( index == 0 )
+        {
+            for ( level = 1; level < EVENTWHEEL_LEVELS; level++ )
+            {
+                Cascade( level );
+
+                if ( ( ( m_tick >> ( EVENTWHEEL_BITS * level ) ) & ( EVENTWHEEL_SLOTS - 1 ) ) != 0 )
+                    break;
+            }
+        }
+
+        // Detach the slot before running anything; events scheduled while running land on a later pulse
+        due.splice( due.end(), m_slots[0][index] );
+        m_tick++;
+
+        for ( ei = due.begin(); ei != due.end(); ei++ )
+            ( *ei )->sSlot( &due, ei );
+
+        // An Event may cancel others that are due alongside it, which removes them from this list
+        while ( !due.empty() )
+        {
+            event = due.front();
+            Remove( event );
+            event->Run();
+        }
+    }
+
+    // Reclaim the handles of everything that ran or was cancelled this pulse
+    m_handles.Compact();
+
+    return;
+}
+
+/* Query */
+/**
+ * @brief Returns the number of events held within the wheel.
+ * @retval uint_t The number of pending events.
+ */
+const uint_t EventWheel::gSize() const
+{
+    return m_handles.Size();
+}
+
+/* Manipulate */
+
+/* Internal */
+/**
+ * @brief Constructor for the EventWheel class.
+ */
+EventWheel::EventWheel()
+{
+    m_tick = 0;
+
+    return;
+}
+
+/**
+ * @brief Destructor for the EventWheel class.
+ */
+EventWheel::~EventWheel()
+{
+    return;
+}
+
+/**
+ * @brief Move every Event from the current slot of a level down to the levels below it.
+ * @param[in] level The level to be cascaded.
+ * @retval void
+ */
+const void EventWheel::Cascade( const uint_t& level )
+{
+    list<Event*> moved;
+
+    moved.splice( moved.end(), m_slots[level][( m_tick >> ( EVENTWHEEL_BITS * level ) ) & ( EVENTWHEEL_SLOTS - 1 )] );
+
+    while ( !moved.empty() )
+        Insert( moved.front(), moved, moved.begin() );
+
+    return;
+}
+
+/**
+ * @brief Place an Event in the slot that will come around on the pulse it expires on.
+ * @param[in] event The Event to be placed.
+ * @param[in] from The list currently holding the Event.
+ * @param[in] pos The position of the Event within from.
+ * @retval void
+ */
+const void EventWheel::Insert( Event* event, list<Event*>& from, const list<Event*>::iterator& pos )
+{
+    uint_t expires = max( event->gExpires(), m_tick );
+    uint_t delta = expires - m_tick;
+    uint_t level = 0, slot = 0;
+
+    while ( level < EVENTWHEEL_LEVELS - 1 && ( delta >> ( EVENTWHEEL_BITS * ( level + 1 ) ) ) != 0 )
+        level++;
+
+    // Too far out for even the top level; park it in the slot that comes around last and place it again from there
+    if ( ( delta >> ( EVENTWHEEL_BITS * level ) ) >= EVENTWHEEL_SLOTS )
+        slot = ( ( m_tick >> ( EVENTWHEEL_BITS * level ) ) + EVENTWHEEL_SLOTS - 1 ) & ( EVENTWHEEL_SLOTS - 1 );
+    else
+        slot = ( expires >> ( EVENTWHEEL_BITS * level ) ) & ( EVENTWHEEL_SLOTS - 1 );
+
+    m_slots[level][slot].splice( m_slots[level][slot].end(), from, pos );
+    event->sSlot( &m_slots[level][slot], pos );
+
+    return;
+}
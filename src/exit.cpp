@@ -26,6 +26,7 @@
 
 #include "h/list.h"
 #include "h/location.h"
+#include "h/pool.h"
 
 /* Core */
 /**
@@ -193,3 +194,26 @@ Exit::~Exit()
 {
     return;
 }
+
+/**
+ * @brief Allocate memory for an Exit from its Pool.
+ * @param[in] size The size of the object being created.
+ * @retval void* A pointer to the memory.
+ */
+void* Exit::operator new( size_t size )
+{
+    return g_global->m_exit_pool->Allocate( size );
+}
+
+/**
+ * @brief Return the memory of an Exit to its Pool.
+ * @param[in] ptr A pointer to the memory of the deleted object.
+ * @param[in] size The size of the deleted object.
+ * @retval void
+ */
+void Exit::operator delete( void* ptr, size_t size )
+{
+    g_global->m_exit_pool->Free( ptr, size );
+
+    return;
+}
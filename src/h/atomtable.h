@@ -0,0 +1,72 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file atomtable.h
+ * @brief The AtomTable class.
+ *
+ *  This file contains the AtomTable class and template functions.
+ */
+#ifndef DEC_ATOMTABLE_H
+#define DEC_ATOMTABLE_H
+
+using namespace std;
+
+/**
+ * @brief Every distinct string shared between Thing objects, such as names and zones, stored once and referred to by Atom.
+ */
+class AtomTable
+{
+    public:
+        /** @name Core */ /**@{*/
+        const void Delete();
+        const Atom Find( const string& text ) const;
+        const Atom Intern( const string& text );
+        const bool New();
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        const Atom gFolded( const Atom& atom ) const;
+        const string& gFoldedText( const Atom& atom ) const;
+        const uint_t gSize() const;
+        const string& gText( const Atom& atom ) const;
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        AtomTable();
+        ~AtomTable();
+        /**@}*/
+
+    private:
+        /**
+         * @brief A single interned string.
+         */
+        class Entry
+        {
+            public:
+                Atom m_folded; /**< The Atom of the text folded to lowercase if #CFG_GAM_CMD_IGNORE_CASE is set, which may be this Atom. */
+                const string* m_text; /**< The text of the Atom, owned by the key within AtomTable::m_atoms. */
+        };
+
+        unordered_map<string,Atom> m_atoms; /**< Every interned string and its Atom. */
+        vector<AtomTable::Entry> m_entries; /**< Every interned string, indexed by Atom. */
+};
+
+#endif
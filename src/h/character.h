@@ -38,14 +38,17 @@ class Character : public Thing
         const bool Clone( const string& name, const uint_t& type );
         const void Delete();
         const void Interpret( const uint_t& security, const string& cmd, const string& args );
+        const void Interpret( const uint_t& security, const string& cmd, const string& args, Command* command );
         const bool New( const string& file, const bool& itemplate, const bool& exists );
         const void Send( const string& msg, Thing* speaker = NULL, Thing* target = NULL ) const;
+        const void Send( const Segment& msg, Thing* speaker = NULL, Thing* target = NULL ) const;
         const bool Serialize() const;
         const bool Unserialize();
         /**@}*/
 
         /** @name Query */ /**@{*/
         const bool gCreation( const uint_t& pos );
+        list<Event*>* gEvents();
         const string gPrompt() const;
         const uint_t gSex() const;
         /**@}*/
@@ -62,7 +65,9 @@ class Character : public Thing
 
     private:
         bool m_creation[MAX_CHR_CREATION]; /**< Track if all creation options have been set. */
+        list<Event*> m_events; /**< Pending events initiated by the character. */
         string m_file; /**< Path to the file on disk. */
+        SlotHandle m_list_handle; /**< Where the character is held within #character_list, or zero if it is a template. */
         uint_t m_sex; /**< The sex of the character. */
 };
 
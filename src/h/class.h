@@ -28,15 +28,23 @@
 
 class Account;
 class AIProg;
+class AtomTable;
 class Brain;
 class Command;
 class Event;
+class EventWheel;
 class Exit;
+class Hasher;
+class IOThread;
 class Plugin;
+class Pool;
+class Reactor;
 class Reset;
+class Resolver;
 class Socket;
     class SocketClient;
     class SocketServer;
+template <class T> class SPSCQueue;
 class Thing;
     class Character;
     class Location;
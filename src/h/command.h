@@ -42,6 +42,7 @@ class Command
 
         /** @name Query */ /**@{*/
         void* gCaller() const;
+        list<Event*>* gEvents();
         const string gFile() const;
         const string gName() const;
         const bool gPreempt() const;
@@ -58,6 +59,7 @@ class Command
 
     private:
         bool m_disabled; /**< If true, the command can only be used by ACT_SECURITY_ADMIN */
+        list<Event*> m_events; /**< Pending events which will execute the command. */
         Plugin* m_plg; /**< Pointer to the associated Plugin. */
         PluginDelete* m_plg_delete; /**< Pointer to the PluginDelete object within the associated Plugin. */
         string m_plg_file; /**< Filename of the Plugin object for reloading later. */
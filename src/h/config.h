@@ -234,6 +234,20 @@
  *                              GAME OPTIONS                               *
  ***************************************************************************/
 /** @name Game Options */ /**@{*/
+/**
+ * @def CFG_GAM_CMD_BUDGET
+ * @brief The maximum number of queued commands run across all clients during a single pulse. Preempt commands aren't counted.
+ * @par Default: 256
+ */
+#define CFG_GAM_CMD_BUDGET 256
+
+/**
+ * @def CFG_GAM_CMD_BURST
+ * @brief The maximum number of queued commands run for a single client during a single pulse. Preempt commands aren't counted.
+ * @par Default: 4
+ */
+#define CFG_GAM_CMD_BURST 4
+
 /**
  * @def CFG_GAM_CMD_IGNORE_CASE
  * @brief Ignore case sensitivity on input from sockets.
@@ -342,6 +356,12 @@
  * @par Default: 128
  */
 #define CFG_MEM_MAX_BITSET 128
+/**
+ * @def CFG_MEM_POOL_BLOCK
+ * @brief Number of instances allocated at once each time the Pool for Event, Exit, or Object objects runs dry.
+ * @par Default: 256
+ */
+#define CFG_MEM_POOL_BLOCK 256
 /**@}*/
 
 /***************************************************************************
@@ -355,6 +375,20 @@
  */
 #define CFG_SEC_CRYPT_METHOD 6
 
+/**
+ * @def CFG_SEC_CRYPT_MAX_HOST
+ * @brief The maximum number of passwords from a single host that may be waiting to be verified at once.
+ * @par Default: 2
+ */
+#define CFG_SEC_CRYPT_MAX_HOST 2
+
+/**
+ * @def CFG_SEC_CRYPT_QUEUE
+ * @brief The maximum number of passwords from all hosts that may be waiting to be verified at once.
+ * @par Default: 256
+ */
+#define CFG_SEC_CRYPT_QUEUE 256
+
 /**
  * @def CFG_SEC_CRYPT_SALT
  * @brief The initial salt string to use with crypt().
@@ -362,6 +396,13 @@
  */
 #define CFG_SEC_CRYPT_SALT "$" SX( CFG_SEC_CRYPT_METHOD ) "$"
 
+/**
+ * @def CFG_SEC_CRYPT_THREADS
+ * @brief The number of threads which hash passwords so that the game thread never waits on crypt().
+ * @par Default: 2
+ */
+#define CFG_SEC_CRYPT_THREADS 2
+
 /**
  * @def CFG_SEC_DIR_MODE
  * @brief The chmod mode to set on directories (accounts) created by the server.
@@ -381,6 +422,76 @@
  */
 #define CFG_SOC_BIND_ADDR "::"
 
+/**
+ * @def CFG_SOC_COMPRESS_LEVEL
+ * @brief The zlib compression level, from 1 (fastest) to 9 (smallest), used for each client that negotiates MCCP2.
+ * @par Default: 6
+ */
+#define CFG_SOC_COMPRESS_LEVEL 6
+
+/**
+ * @def CFG_SOC_COMPRESS_MEMLEVEL
+ * @brief The zlib memory level, from 1 to 9, used for each client that negotiates MCCP2. Each level doubles the memory held by a client's compression stream.
+ * @par Default: 8
+ */
+#define CFG_SOC_COMPRESS_MEMLEVEL 8
+
+/**
+ * @def CFG_SOC_INPUT_BYTE_BURST
+ * @brief The number of bytes a client may send at once before being held to #CFG_SOC_INPUT_BYTE_RATE.
+ * @par Default: 16384
+ */
+#define CFG_SOC_INPUT_BYTE_BURST 16384
+
+/**
+ * @def CFG_SOC_INPUT_BYTE_RATE
+ * @brief The number of bytes per second read from each client. Anything faster is left in the kernel, pushing back on the client.
+ * @par Default: 4096
+ */
+#define CFG_SOC_INPUT_BYTE_RATE 4096
+
+/**
+ * @def CFG_SOC_INPUT_COMMAND_BURST
+ * @brief The number of commands a client may send at once before being held to #CFG_SOC_INPUT_COMMAND_RATE.
+ * @par Default: 20
+ */
+#define CFG_SOC_INPUT_COMMAND_BURST 20
+
+/**
+ * @def CFG_SOC_INPUT_COMMAND_RATE
+ * @brief The number of commands per second accepted from each client. Anything faster is handled per #CFG_SOC_INPUT_OVERFLOW.
+ * @par Default: 10
+ */
+#define CFG_SOC_INPUT_COMMAND_RATE 10
+
+/**
+ * @def CFG_SOC_INPUT_OVERFLOW
+ * @brief How commands beyond #CFG_SOC_INPUT_COMMAND_RATE or #CFG_SOC_MAX_COMMAND_QUEUE are handled, from #SOC_OVERFLOW.
+ * @par Default: SOC_OVERFLOW_WARN
+ */
+#define CFG_SOC_INPUT_OVERFLOW SOC_OVERFLOW_WARN
+
+/**
+ * @def CFG_SOC_INPUT_RETRY
+ * @brief Milliseconds an I/O thread waits before reading again from clients which exhausted #CFG_SOC_INPUT_BYTE_BURST.
+ * @par Default: 100
+ */
+#define CFG_SOC_INPUT_RETRY 100
+
+/**
+ * @def CFG_SOC_IO_THREADS
+ * @brief The number of threads which handle socket reads, writes and telnet parsing on behalf of the game thread.
+ * @par Default: 2
+ */
+#define CFG_SOC_IO_THREADS 2
+
+/**
+ * @def CFG_SOC_LISTENERS
+ * @brief The number of listening sockets to open on the server port. Above 1 each is bound with SO_REUSEPORT so the kernel spreads new connections across several accept queues.
+ * @par Default: 1
+ */
+#define CFG_SOC_LISTENERS 1
+
 /**
  * @def CFG_SOC_MIN_PORTNUM
  * @brief The listening server socket must be above this port.
@@ -388,6 +499,27 @@
  */
 #define CFG_SOC_MIN_PORTNUM 1024
 
+/**
+ * @def CFG_SOC_MAX_ACCEPT
+ * @brief The maximum number of connections each listening socket will accept in a single pulse. The remainder wait in the backlog for the next pulse.
+ * @par Default: 256
+ */
+#define CFG_SOC_MAX_ACCEPT 256
+
+/**
+ * @def CFG_SOC_MAX_COMMAND_QUEUE
+ * @brief The maximum number of commands waiting to be run for each client. Anything further is handled per #CFG_SOC_INPUT_OVERFLOW.
+ * @par Default: 50
+ */
+#define CFG_SOC_MAX_COMMAND_QUEUE 50
+
+/**
+ * @def CFG_SOC_MAX_EVENTS
+ * @brief The maximum number of socket events to collect from the reactor in a single pass.
+ * @par Default: 1024
+ */
+#define CFG_SOC_MAX_EVENTS 1024
+
 /**
  * @def CFG_SOC_MAX_IDLE
  * @brief (Minutes / tick rate) before disconnecting an idle socket. Approx 30 minutes.
@@ -395,12 +527,26 @@
  */
 #define CFG_SOC_MAX_IDLE ( ( 30 * 60 * USLEEP_MAX ) / ( USLEEP_MAX / CFG_GAM_PULSE_RATE ) )
 
+/**
+ * @def CFG_SOC_MAX_IOVEC
+ * @brief The maximum number of buffered output segments to hand to the kernel in a single write.
+ * @par Default: 64
+ */
+#define CFG_SOC_MAX_IOVEC 64
+
+/**
+ * @def CFG_SOC_MAX_OUTPUT
+ * @brief Bytes of unsent output a client may accumulate before it is disconnected for not reading.
+ * @par Default: 1048576
+ */
+#define CFG_SOC_MAX_OUTPUT 1048576
+
 /**
  * @def CFG_SOC_MAX_PENDING
- * @brief The maximum number of pending connections to allow in the listen backlog.
- * @par Default: 5
+ * @brief The maximum number of pending connections to allow in the listen backlog. The host OS may cap this further (net.core.somaxconn).
+ * @par Default: 1024
  */
-#define CFG_SOC_MAX_PENDING 5
+#define CFG_SOC_MAX_PENDING 1024
 
 /**
  * @def CFG_SOC_MAX_PORTNUM
@@ -409,12 +555,61 @@
  */
 #define CFG_SOC_MAX_PORTNUM 65536
 
+/**
+ * @def CFG_SOC_OUTPUT_HIGH_WATER
+ * @brief Once a client has this many bytes of unsent output, no further input is read from it until the output drains to #CFG_SOC_OUTPUT_LOW_WATER.
+ * @par Default: 262144
+ */
+#define CFG_SOC_OUTPUT_HIGH_WATER 262144
+
+/**
+ * @def CFG_SOC_OUTPUT_LOW_WATER
+ * @brief A throttled client resumes having its input read once its unsent output drains to this many bytes.
+ * @par Default: 65536
+ */
+#define CFG_SOC_OUTPUT_LOW_WATER 65536
+
 /**
  * @def CFG_SOC_PORTNUM
  * @brief Port number to listen on if not specified on the command line.
  * @par Default: 4321
  */
 #define CFG_SOC_PORTNUM 4321
+
+/**
+ * @def CFG_SOC_RESOLVE_CACHE
+ * @brief The maximum number of addresses to remember the hostname of. The least recently used are forgotten first.
+ * @par Default: 4096
+ */
+#define CFG_SOC_RESOLVE_CACHE 4096
+
+/**
+ * @def CFG_SOC_RESOLVE_NEGATIVE_TTL
+ * @brief Seconds to remember that an address has no hostname before looking it up again.
+ * @par Default: 300
+ */
+#define CFG_SOC_RESOLVE_NEGATIVE_TTL 300
+
+/**
+ * @def CFG_SOC_RESOLVE_QUEUE
+ * @brief The maximum number of addresses waiting to be looked up. Clients connecting while the queue is full keep their numeric address.
+ * @par Default: 1024
+ */
+#define CFG_SOC_RESOLVE_QUEUE 1024
+
+/**
+ * @def CFG_SOC_RESOLVE_THREADS
+ * @brief The number of threads which perform reverse DNS lookups of client addresses.
+ * @par Default: 4
+ */
+#define CFG_SOC_RESOLVE_THREADS 4
+
+/**
+ * @def CFG_SOC_RESOLVE_TTL
+ * @brief Seconds to remember the hostname of an address before looking it up again.
+ * @par Default: 3600
+ */
+#define CFG_SOC_RESOLVE_TTL 3600
 /**@}*/
 
 /***************************************************************************
@@ -491,6 +686,13 @@
  */
 #define CFG_STR_ACT_NEW_ERROR "An error occurred while attempting to create that account." CRLF
 
+/**
+ * @def CFG_STR_ACT_PASSWORD_BUSY
+ * @brief String sent when a password can't be verified yet because too many others from the same host are still being verified.
+ * @par Default: CRLF "Too many passwords are being verified from your host; please try again." CRLF
+ */
+#define CFG_STR_ACT_PASSWORD_BUSY CRLF "Too many passwords are being verified from your host; please try again." CRLF
+
 /**
  * @def CFG_STR_ACT_PASSWORD_CONFIRM
  * @brief String sent to request the user confirms their new account password.
@@ -701,6 +903,13 @@
  */
 #define CFG_STR_IDLE CRLF "Idle limit reached. Goodbye." CRLF
 
+/**
+ * @def CFG_STR_INPUT_OVERFLOW
+ * @brief String sent when commands are ignored for arriving too quickly.
+ * @par Default: CRLF "You are sending commands too quickly; some have been ignored." CRLF
+ */
+#define CFG_STR_INPUT_OVERFLOW CRLF "You are sending commands too quickly; some have been ignored." CRLF
+
 /**
  * @def CFG_STR_LOGIN
  * @brief String sent on initial socket connection.
@@ -797,6 +1006,13 @@
  *                              THING OPTIONS                              *
  ***************************************************************************/
 /** @name Thing Options */ /**@{*/
+/**
+ * @def CFG_THG_ID_EPOCH
+ * @brief Milliseconds since the Unix epoch from which generated thing ids count. Must never be changed once ids have been saved.
+ * @par Default: 1325376000000 (2012-01-01 00:00:00 UTC)
+ */
+#define CFG_THG_ID_EPOCH 1325376000000ULL
+
 /**
  * @def CFG_THG_ID_MAX_LEN
  * @brief The maximum allowable length for a thing id.
@@ -811,6 +1027,13 @@
  */
 #define CFG_THG_ID_MIN_LEN 1
 
+/**
+ * @def CFG_THG_ID_NODE
+ * @brief Identifies this server within generated thing ids, from 0 to 1023. Servers which share a world must each use a different value.
+ * @par Default: 0
+ */
+#define CFG_THG_ID_NODE 0
+
 /**
  * @def CFG_THG_NAME_MAX_LEN
  * @brief The maximum allowable length for a thing name when the thing is associated to an account.
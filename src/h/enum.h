@@ -95,6 +95,17 @@ enum ACT_SECURITY
 };
 /**@}*/
 
+/** @name AtomTable */ /**@{*/
+/**
+ * @enum ATOM
+ */
+enum ATOM
+{
+    ATOM_EMPTY = 0,         /**< Always the empty string. */
+    ATOM_NONE  = 0xFFFFFFFF /**< Returned by AtomTable::Find() for strings which have never been interned. */
+};
+/**@}*/
+
 /** @name Character */ /**@{*/
 /**
  * @enum CHR_CREATION
@@ -138,9 +149,10 @@ enum EVENT_TYPE
  */
 enum HANDLER_FIND
 {
-    HANDLER_FIND_ID   = 0, /**< Search for object by id, such as "sys.entrypoint". */
-    HANDLER_FIND_NAME = 1, /**< Search for object by name, such as "Chris". */
-    MAX_HANDLER_FIND  = 2  /**< Safety limit for looping. */
+    HANDLER_FIND_ID        = 0, /**< Search for object by exact id, such as "sys.entrypoint". */
+    HANDLER_FIND_NAME      = 1, /**< Search for object by name, such as "Chris". */
+    HANDLER_FIND_ID_PREFIX = 2, /**< Search for the first object whose id begins with the search term, such as "sys.entry". Walks the whole list. */
+    MAX_HANDLER_FIND       = 3  /**< Safety limit for looping. */
 };
 
 /**
@@ -148,9 +160,9 @@ enum HANDLER_FIND
  */
 enum HANDLER_SCOPE
 {
-    HANDLER_SCOPE_INVENTORY = 0, /**< Search only within thing->gContents(). */
+    HANDLER_SCOPE_INVENTORY = 0, /**< Search only within the contents of thing. */
     HANDLER_SCOPE_LOCATION  = 1, /**< Search only within thing->gContainer(). */
-    HANDLER_SCOPE_LOC_INV   = 2, /**< Search within thing->gContainer() then thing->gContents(). */
+    HANDLER_SCOPE_LOC_INV   = 2, /**< Search within thing->gContainer() then the contents of thing. */
     MAX_HANDLER_SCOPE       = 3, /**< Safety limit for looping. */
 };
 /**@}*/
@@ -221,12 +233,38 @@ enum SOC_STATE
     SOC_STATE_ENTER_GAME               = 16,  /**< An internal state where the loaded character is entered into the game. */
     SOC_STATE_RECONNECTING             = 17,  /**< A Socket that is in the process of being reassociated to a linkdead Character in the game. */
     SOC_STATE_DISC_LINKDEAD            = 18,  /**< A Socket being disconnected due to a new login session, such as a link-dead Character. */
+    SOC_STATE_VERIFYING                = 19,  /**< A Socket waiting on a password it sent to be hashed by the Hasher. */
     SOC_STATE_PLAYING                  = 100, /**< A Socket fully within the game world and actively playing. */
     MAX_SOC_STATE                      = 101  /**< Safety limit for looping. */
 };
 /**@}*/
 
 /** @name SocketClient */ /**@{*/
+/**
+ * @enum SOC_INPUT
+ */
+enum SOC_INPUT
+{
+    SOC_INPUT_LINE   = 0, /**< A complete line of input from the client. */
+    SOC_INPUT_TELOPT = 1, /**< A telnet negotiation command and option received from the client. */
+    MAX_SOC_INPUT    = 2  /**< Safety limit for looping. */
+};
+
+/**
+ * @enum SOC_IO
+ */
+enum SOC_IO
+{
+    SOC_IO_ADD    = 0, /**< Game to I/O thread: begin watching a new client. */
+    SOC_IO_CLOSE  = 1, /**< Game to I/O thread: write any remaining output and stop watching a client. */
+    SOC_IO_CLOSED = 2, /**< I/O to game thread: the client is no longer referenced by the I/O thread and may be released. */
+    SOC_IO_FLUSH  = 3, /**< Game to I/O thread: new output is waiting within a client's output queue. */
+    SOC_IO_HANGUP = 4, /**< I/O to game thread: the connection failed while reading or writing. */
+    SOC_IO_INPUT  = 5, /**< I/O to game thread: new input is waiting within a client's input queue. */
+    SOC_IO_STOP   = 6, /**< Game to I/O thread: exit the thread. */
+    MAX_SOC_IO    = 7  /**< Safety limit for looping. */
+};
+
 /**
  * @enum SOC_LOGIN
  */
@@ -238,14 +276,39 @@ enum SOC_LOGIN
     MAX_SOC_LOGIN       = 3  /**< Safety limit for looping. */
 };
 
+/**
+ * @enum SOC_OVERFLOW
+ */
+enum SOC_OVERFLOW
+{
+    SOC_OVERFLOW_DROP       = 0, /**< Silently ignore the command. */
+    SOC_OVERFLOW_WARN       = 1, /**< Ignore the command and tell the client. */
+    SOC_OVERFLOW_DISCONNECT = 2, /**< Disconnect the client. */
+    MAX_SOC_OVERFLOW        = 3  /**< Safety limit for looping. */
+};
+
+/**
+ * @enum SOC_TELNET
+ */
+enum SOC_TELNET
+{
+    SOC_TELNET_DATA   = 0, /**< Plain data; scanning for the next IAC. */
+    SOC_TELNET_IAC    = 1, /**< An IAC has been received and the command byte is expected next. */
+    SOC_TELNET_OPTION = 2, /**< A DO, DONT, WILL, or WONT has been received and the option byte is expected next. */
+    SOC_TELNET_SB     = 3, /**< Within a subnegotiation; scanning for the IAC SE which ends it. */
+    SOC_TELNET_SB_IAC = 4, /**< An IAC has been received within a subnegotiation. */
+    MAX_SOC_TELNET    = 5  /**< Safety limit for looping. */
+};
+
 /**
  * @enum SOC_TELOPT
  */
 enum SOC_TELOPT
 {
-    SOC_TELOPT_ECHO = 0, /**< Telopt ECHO (1) */
-    SOC_TELOPT_MSP  = 1, /**< Telopt MSP (90) */
-    MAX_SOC_TELOPT  = 2  /**< Safety limit for looping. */
+    SOC_TELOPT_ECHO      = 0, /**< Telopt ECHO (1) */
+    SOC_TELOPT_MSP       = 1, /**< Telopt MSP (90) */
+    SOC_TELOPT_COMPRESS2 = 2, /**< Telopt COMPRESS2 (86), MCCP version 2 */
+    MAX_SOC_TELOPT       = 3  /**< Safety limit for looping. */
 };
 /**@}*/
 
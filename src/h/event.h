@@ -33,26 +33,36 @@ class Event
 {
     public:
         /** @name Core */ /**@{*/
+        static const void Cancel( list<Event*>* events, const Command* command = NULL );
         const void Delete();
         const bool New( const string& cmd, const string& args, Character* character, Command* command, const uint_t& type, const uint_t& time );
         const bool New( const string& args, const uint_t& type, const uint_t& time );
         const bool New( const string& cmd, const string& args, SocketClient* client, Command* command, const uint_t& type, const uint_t& time );
         const void Run();
-        const bool Update();
         /**@}*/
 
         /** @name Query */ /**@{*/
         Character* gCharacter() const;
         Command* gCommand() const;
+        const uint_t gExpires() const;
+        const SlotHandle gHandle() const;
+        list<Event*>* gSlot() const;
+        const list<Event*>::iterator gSlotPosition() const;
         const uint_t gTime() const;
         /**@}*/
 
         /** @name Manipulate */ /**@{*/
+        const void sHandle( const SlotHandle& handle );
+        const void sSlot( list<Event*>* slot, const list<Event*>::iterator& pos );
         /**@}*/
 
         /** @name Internal */ /**@{*/
         Event();
         ~Event();
+        void* operator new( size_t size );
+        void operator delete( void* ptr, size_t size );
+        const void Link();
+        const void Unlink();
         /**@}*/
 
     private:
@@ -61,7 +71,13 @@ class Event
         Character* m_character; /**< The Character who initiated the Event. */
         SocketClient* m_client; /**< The client who initiated the Event. */
         Command* m_command; /**< Command to execute. */
-        uint_t m_time; /**< Amount of time to wait before executing. Based on #CFG_GAM_PULSE_RATE. */
+        list<Event*>::iterator m_command_pos; /**< Position of the Event within the pending events of m_command. */
+        uint_t m_expires; /**< The pulse on which the Event is due to execute. Based on #CFG_GAM_PULSE_RATE. */
+        SlotHandle m_handle; /**< Identifies the Event within the EventWheel without holding a pointer to it, or 0 if it is not scheduled. */
+        bool m_linked; /**< Set while the Event is held within the pending events of its owners. */
+        list<Event*>::iterator m_owner_pos; /**< Position of the Event within the pending events of m_character or m_client. */
+        list<Event*>* m_slot; /**< The slot of the EventWheel holding the Event, or NULL if it is not scheduled. */
+        list<Event*>::iterator m_slot_pos; /**< Position of the Event within m_slot. */
         uint_t m_type; /**< The type of function to be called. */
 };
 
@@ -0,0 +1,82 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file eventwheel.h
+ * @brief The EventWheel class.
+ *
+ *  This file contains the EventWheel class and template functions.
+ */
+#ifndef DEC_EVENTWHEEL_H
+#define DEC_EVENTWHEEL_H
+
+using namespace std;
+
+/**
+ * @def EVENTWHEEL_BITS
+ * @brief Number of bits of the expiry pulse covered by each level of the EventWheel.
+ */
+#define EVENTWHEEL_BITS 8
+
+/**
+ * @def EVENTWHEEL_LEVELS
+ * @brief Number of levels within the EventWheel. Events due further out than the last level can reach are held in its final slot.
+ */
+#define EVENTWHEEL_LEVELS 4
+
+/**
+ * @def EVENTWHEEL_SLOTS
+ * @brief Number of slots within each level of the EventWheel.
+ */
+#define EVENTWHEEL_SLOTS ( 1 << EVENTWHEEL_BITS )
+
+/**
+ * @brief A hierarchical timing wheel holding every pending Event, keyed on the pulse it is due.
+ */
+class EventWheel
+{
+    public:
+        /** @name Core */ /**@{*/
+        const bool Add( Event* event );
+        const void Delete();
+        Event* Find( const SlotHandle& handle ) const;
+        const bool New();
+        const bool Remove( Event* event );
+        const void Update();
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        const uint_t gSize() const;
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        EventWheel();
+        ~EventWheel();
+        const void Cascade( const uint_t& level );
+        const void Insert( Event* event, list<Event*>& from, const list<Event*>::iterator& pos );
+        /**@}*/
+
+    private:
+        SlotMap<Event*> m_handles; /**< Every Event held within the wheel, resolving the handle given to each. */
+        list<Event*> m_slots[EVENTWHEEL_LEVELS][EVENTWHEEL_SLOTS]; /**< Pending events. Each slot of level n holds the events due within one span of EVENTWHEEL_SLOTS^n pulses. */
+        uint_t m_tick; /**< The next pulse to be processed. */
+};
+
+#endif
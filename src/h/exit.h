@@ -53,6 +53,8 @@ class Exit
         /** @name Internal */ /**@{*/
         Exit();
         ~Exit();
+        void* operator new( size_t size );
+        void operator delete( void* ptr, size_t size );
         /**@}*/
 
     private:
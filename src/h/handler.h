@@ -50,7 +50,9 @@ namespace Handler
     /** @name Manipulate */ /**@{*/
     const void AttachAccount( SocketClient* client, const string& cmd, const string& args );
     const void AttachCharacter( SocketClient* client, const string& cmd, const string& args );
+    const void PasswordVerified( SocketClient* client, const uint_t& state, const string& hash );
     const void Reconnect( SocketClient* client, Character* character );
+    const bool VerifyPassword( SocketClient* client, const string& password );
     /**@}*/
 
     /** @name Internal */ /**@{*/
@@ -0,0 +1,79 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file hasher.h
+ * @brief The Hasher class.
+ *
+ *  This file contains the Hasher class and template functions.
+ */
+#ifndef DEC_HASHER_H
+#define DEC_HASHER_H
+
+using namespace std;
+
+/**
+ * @brief A fixed pool of threads which hash account passwords on behalf of SocketClient objects in #SOC_STATE_VERIFYING.
+ */
+class Hasher
+{
+    public:
+        /**
+         * @brief A single password to be hashed, and later its result.
+         */
+        class Job
+        {
+            public:
+                SlotHandle m_handle; /**< Handle within socket_client_list of the SocketClient the password was received from. */
+                string m_hash; /**< The result of hashing m_password, or empty if hashing failed. */
+                string m_host; /**< Hostname of the SocketClient when the job was queued, which the per-host limit was counted against. */
+                string m_password; /**< The password to hash. Cleared once hashed. */
+                string m_salt; /**< The salt to hash m_password with. */
+                uint_t m_state; /**< State from #SOC_STATE the SocketClient was in when it sent the password, used to resume it. */
+        };
+
+        /** @name Core */ /**@{*/
+        const void Delete();
+        const bool Hash( const Hasher::Job& job );
+        const bool New();
+        const bool Pop( Hasher::Job& job );
+        const bool Update( crypt_data& data );
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        static void* tUpdate( void* data );
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        Hasher();
+        ~Hasher();
+        /**@}*/
+
+    private:
+        map<string,uint_t> m_hosts; /**< Number of jobs queued or being hashed for each hostname. Only accessed by the game thread. */
+        pthread_mutex_t m_mutex; /**< Guards every member shared between the game thread and the pool. */
+        deque<Hasher::Job> m_queue; /**< Jobs waiting for a thread from the pool. */
+        deque<Hasher::Job> m_results; /**< Hashed jobs waiting to be collected by the game thread. */
+        bool m_running; /**< Cleared to ask the pool to exit. */
+        vector<pthread_t> m_threads; /**< The running threads. */
+        pthread_cond_t m_wake; /**< Signalled when a job is queued or the pool is asked to exit. */
+};
+
+#endif
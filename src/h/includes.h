@@ -32,9 +32,27 @@
 #include "enum.h"
 #include "config.h"
 #include "class.h"
+#include "slotmap.h"
+#include "spscqueue.h"
 #include "namespace.h"
 #include "globals.h"
 
+/**
+ * @brief A string interned within the AtomTable. Two Atom values are equal only if their strings are equal.
+ */
+typedef uint32_t Atom;
+
+/**
+ * @brief An immutable piece of output. A message sent to many SocketClient objects is built once and shared by all of them.
+ */
+typedef shared_ptr<const string> Segment;
+
+/**
+ * @brief Thing objects keyed by id, for lookups which need not walk the list holding them. Ids are compared without regard to case if
+ * #CFG_GAM_CMD_IGNORE_CASE is set.
+ */
+typedef unordered_map<string,Thing*,Utils::FoldedHash,Utils::FoldedEqual> ThingIndex;
+
 /**
  * @brief Used as a pointer to the New() function within an implemented class.
  */
@@ -0,0 +1,72 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file iothread.h
+ * @brief The IOThread class.
+ *
+ *  This file contains the IOThread class and template functions.
+ */
+#ifndef DEC_IOTHREAD_H
+#define DEC_IOTHREAD_H
+
+using namespace std;
+
+/**
+ * @brief A thread which owns the sockets of a share of the SocketClient objects, performing all reads, writes and telnet parsing for them.
+ */
+class IOThread
+{
+    public:
+        /** @name Core */ /**@{*/
+        const void Delete();
+        const void Hangup( SocketClient* socket_client );
+        const bool New();
+        const void Notify( SocketClient* socket_client, const uint_t& type );
+        const bool Pop( pair<SocketClient*,uint_t>& notice );
+        const void Post( SocketClient* socket_client, const uint_t& type );
+        const void Read( SocketClient* socket_client );
+        const bool Update();
+        const void Wake();
+        const void Write( SocketClient* socket_client );
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        static void* tUpdate( void* data );
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        IOThread();
+        ~IOThread();
+        /**@}*/
+
+    private:
+        vector<SocketClient*> m_limited; /**< Clients whose reads stopped short for exceeding #CFG_SOC_INPUT_BYTE_RATE, retried every #CFG_SOC_INPUT_RETRY milliseconds. Only accessed by the I/O thread. */
+        SPSCQueue< pair<SocketClient*,uint_t> > m_notices; /**< Notices from the I/O thread to the game thread from #SOC_IO. */
+        bool m_notified; /**< Set once the I/O thread has queued a notice that the game thread hasn't been woken for. Only accessed by the I/O thread. */
+        SPSCQueue< pair<SocketClient*,uint_t> > m_posts; /**< Requests from the game thread to the I/O thread from #SOC_IO. */
+        bool m_posted; /**< Set once the game thread has queued a request that the I/O thread hasn't been woken for. Only accessed by the game thread. */
+        Reactor* m_reactor; /**< Readiness notification for all SocketClient objects owned by this thread. */
+        chrono::steady_clock::time_point m_retry; /**< Time at which the clients within m_limited are next read. Only accessed by the I/O thread. */
+        bool m_running; /**< True while the thread has been started and not yet joined. Only accessed by the game thread. */
+        pthread_t m_thread; /**< The running thread. */
+};
+
+#endif
@@ -43,7 +43,7 @@ class Location : public Thing
         /**@}*/
 
         /** @name Query */ /**@{*/
-        vector<Exit*> gExits() const;
+        const vector<Exit*>& gExits() const;
         /**@}*/
 
         /** @name Manipulate */ /**@{*/
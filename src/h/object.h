@@ -52,10 +52,13 @@ class Object : public Thing
         /** @name Internal */ /**@{*/
         Object();
         ~Object();
+        void* operator new( size_t size );
+        void operator delete( void* ptr, size_t size );
         /**@}*/
 
     private:
         string m_file; /**< Path to the file on disk. */
+        SlotHandle m_list_handle; /**< Where the object is held within #object_list, or zero if it is a template. */
 };
 
 #endif
@@ -0,0 +1,69 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file pool.h
+ * @brief The Pool class.
+ *
+ *  This file contains the Pool class and template functions.
+ */
+#ifndef DEC_POOL_H
+#define DEC_POOL_H
+
+using namespace std;
+
+/**
+ * @brief Fixed size chunks of memory carved from blocks of #CFG_MEM_POOL_BLOCK, for classes which are created and deleted often.
+ */
+class Pool
+{
+    public:
+        /** @name Core */ /**@{*/
+        void* Allocate( const size_t& size );
+        const void Delete();
+        const void Free( void* ptr, const size_t& size );
+        const bool New( const string& name, const size_t& size );
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        const uint_t gAllocations() const;
+        const uint_t gBlocks() const;
+        const uint_t gFree() const;
+        const uint_t gInUse() const;
+        const string gName() const;
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        Pool();
+        ~Pool();
+        const bool Grow();
+        /**@}*/
+
+    private:
+        uint_t m_allocations; /**< Total number of chunks handed out since boot. */
+        vector<char*> m_blocks; /**< Every block of chunks allocated by the pool. */
+        void* m_free; /**< The first unused chunk. Each unused chunk holds a pointer to the next. */
+        uint_t m_free_count; /**< Number of unused chunks. */
+        uint_t m_in_use; /**< Number of chunks currently handed out. */
+        string m_name; /**< Name of the class served by the pool, for logging and status output. */
+        size_t m_size; /**< Size of each chunk, rounded up to keep every chunk aligned. */
+};
+
+#endif
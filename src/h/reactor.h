@@ -0,0 +1,69 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file reactor.h
+ * @brief The Reactor class.
+ *
+ *  This file contains the Reactor class and template functions.
+ */
+#ifndef DEC_REACTOR_H
+#define DEC_REACTOR_H
+
+using namespace std;
+
+/**
+ * @brief Readiness notification for Socket objects, implemented on top of epoll.
+ */
+class Reactor
+{
+    public:
+        /** @name Core */ /**@{*/
+        const bool Add( Socket* socket, const uint_t& events );
+        const void Delete();
+        const bool Modify( Socket* socket, const uint_t& events );
+        const bool New();
+        const bool Remove( Socket* socket );
+        const sint_t Wait( const sint_t& timeout );
+        const bool Wake();
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        const uint_t gEvents( const uint_t& pos ) const;
+        const uint_t gExpired() const;
+        Socket* gSocket( const uint_t& pos ) const;
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        const bool sTimer( const uint_t& rate );
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        Reactor();
+        ~Reactor();
+        /**@}*/
+
+    private:
+        sint_t m_descriptor; /**< File descriptor of the epoll instance. */
+        vector<epoll_event> m_events; /**< Events returned by the most recent call to Reactor::Wait(). */
+        uint_t m_expired; /**< Number of timer deadlines that passed during the most recent call to Reactor::Wait(). */
+        uint_t m_ready; /**< Number of valid entries within m_events. */
+        sint_t m_timer; /**< File descriptor of the timerfd used for periodic deadlines. */
+        sint_t m_wake; /**< File descriptor of the eventfd used by other threads to interrupt Reactor::Wait(). */
+};
+
+#endif
@@ -0,0 +1,90 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file resolver.h
+ * @brief The Resolver class.
+ *
+ *  This file contains the Resolver class and template functions.
+ */
+#ifndef DEC_RESOLVER_H
+#define DEC_RESOLVER_H
+
+using namespace std;
+
+/**
+ * @brief A fixed pool of threads which perform reverse DNS lookups for SocketClient objects, backed by a cache of recent results.
+ */
+class Resolver
+{
+    public:
+        /**
+         * @brief The signature of a function which performs a single reverse lookup.
+         * @param[in] addr The numeric address to look up.
+         * @param[out] hostname The hostname found for addr.
+         * @retval false Returned if no hostname could be found.
+         * @retval true Returned if hostname was set.
+         */
+        typedef const bool (*Function)( const string& addr, string& hostname );
+
+        /**
+         * @brief A single cached lookup result.
+         */
+        class Entry
+        {
+            public:
+                chrono::steady_clock::time_point m_expires; /**< Time after which the result must be looked up again. */
+                string m_hostname; /**< The hostname found, or empty if the lookup failed. */
+                list<string>::iterator m_recent; /**< Position of the address within Resolver::m_recent. */
+        };
+
+        /** @name Core */ /**@{*/
+        const void Delete();
+        const bool Lookup( const SlotHandle& handle, const string& addr, string& hostname );
+        const bool New();
+        const bool Pop( pair<SlotHandle,string>& result );
+        static const bool Reverse( const string& addr, string& hostname );
+        const bool Update();
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        const void sFunction( Function function );
+        static void* tUpdate( void* data );
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        Resolver();
+        ~Resolver();
+        /**@}*/
+
+    private:
+        map<string,Resolver::Entry> m_cache; /**< Recent results keyed by numeric address. */
+        Function m_function; /**< The function used to perform each lookup; Resolver::Reverse() unless replaced, such as by a stub for testing. */
+        pthread_mutex_t m_mutex; /**< Guards every member shared between the game thread and the pool. */
+        map< string,vector<SlotHandle> > m_pending; /**< Handles of the SocketClient objects waiting on each address that has been queued or is being looked up. */
+        deque<string> m_queue; /**< Addresses waiting for a thread from the pool. */
+        list<string> m_recent; /**< Addresses within m_cache, most recently used first. */
+        deque< pair<SlotHandle,string> > m_results; /**< Completed lookups waiting to be collected by the game thread, as client handle and hostname. */
+        bool m_running; /**< Cleared to ask the pool to exit. */
+        vector<pthread_t> m_threads; /**< The running threads. */
+        pthread_cond_t m_wake; /**< Signalled when an address is queued or the pool is asked to exit. */
+};
+
+#endif
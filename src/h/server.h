@@ -83,12 +83,21 @@ namespace Server
             ~Global();
             /**@}*/
 
-            SocketServer* m_listen; /**< The listening server-side socket. */
-            vector<Character*>::iterator m_next_character; /**< Used as the next iterator in all loops dealing with Character objects to prevent nested processing loop problems. */
-            vector<Event*>::iterator m_next_event; /**< Used as the next iterator in all loops dealing with Event objects to prevent nested processing loop problems. */
-            vector<Object*>::iterator m_next_object; /**< Used as the next iterator in all loops dealing with Object objects to prevent nested processing loop problems. */
-            vector<SocketClient*>::iterator m_next_socket_client; /**< Used as the next iterator in all loops dealing with SocketClient objects to prevent nested processing loop problems. */
+            AtomTable* m_atom_table; /**< Every name, zone and location id held by a Thing. */
+            uint_t m_command_revision; /**< Incremented whenever a Command is loaded or unloaded, invalidating any Command pointer cached alongside the value it had. */
+            Pool* m_event_pool; /**< Memory for every Event. */
+            EventWheel* m_event_wheel; /**< Every Event pending execution, keyed on the pulse it is due. */
+            Pool* m_exit_pool; /**< Memory for every Exit. */
+            Hasher* m_hasher; /**< Hashes passwords received during login. */
+            uint_t m_idle_check; /**< The pulse on which SocketClient objects were last checked for being idle. */
+            vector<IOThread*> m_io_threads; /**< Threads which own the sockets of all SocketClient objects. */
+            SocketServer* m_listen; /**< The listening server-side socket. Carried across a reboot and holds the byte counters for all clients. */
+            vector<SocketServer*> m_listeners; /**< Every listening socket, m_listen first, followed by any extra SO_REUSEPORT sockets sharing its port. */
+            Pool* m_object_pool; /**< Memory for every Object. */
             uint_t m_port; /**< Port number to be passed to the associated SocketServer. */
+            uint_t m_pulse; /**< Number of pulses the game loop has completed since boot. */
+            Reactor* m_reactor; /**< Readiness notification for the SocketServer, the pulse timer and notices from the IOThread objects. */
+            Resolver* m_resolver; /**< Looks up the hostname of each SocketClient. */
             bool m_shutdown; /**< Shutdown state of the game. */
             chrono::high_resolution_clock::time_point m_time_boot; /**< Time the Server was first booted. */
             chrono::high_resolution_clock::time_point m_time_current; /**< Current time from the host OS. */
@@ -105,11 +114,17 @@ namespace Server
             /**@}*/
 
             /** @name Query */ /**@{*/
+            const uint_t gInputDropped() const;
+            const uint_t gInputLimited() const;
+            const uint_t gPulseOverrun() const;
             const uint_t gSocketClose() const;
             const uint_t gSocketOpen() const;
             /**@}*/
 
             /** @name Manipulate */ /**@{*/
+            const bool aInputLimited( const uint_t& amount );
+            const bool sInputDropped( const uint_t& amount );
+            const bool sPulseOverrun( const uint_t& amount );
             const bool sSocketClose( const uint_t& amount );
             const bool sSocketOpen( const uint_t& amount );
             /**@}*/
@@ -124,6 +139,9 @@ namespace Server
             uint_t m_dir_open; /**< Total number of directories opened by the Server. */
 
         private:
+            uint_t m_input_dropped; /**< Total number of commands ignored for exceeding a client's command rate or queue depth. */
+            atomic<uint_t> m_input_limited; /**< Total number of times a client's reads were paused for exceeding its byte rate. Updated by the I/O threads. */
+            uint_t m_pulse_overrun; /**< Total number of pulse deadlines that passed before the Server was able to service them. */
             uint_t m_socket_close; /**< Total number of SocketClient and SocketServer objects closed by the Server. */
             uint_t m_socket_open; /**< Total number of SocketClient and SocketServer objects opened by the Server. */
     };
@@ -131,6 +149,7 @@ namespace Server
     /** @name Core */ /**@{*/
     const void Broadcast( const string& msg );
     const bool BuildPlugin( const string& file, const bool& force = false );
+    const void FreeDeleted();
     const void LinkExits();
     const bool LoadCommands();
     const bool LoadLocations();
@@ -139,6 +158,7 @@ namespace Server
     const bool PollSockets();
     const void ProcessEvents();
     const void ProcessInput();
+    const void ProcessOutput();
     const void RebootRecovery( const bool& reboot );
     const bool ReloadCommand( const string& name );
     const void Startup( const sint_t& desc = 0 );
@@ -0,0 +1,251 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file slotmap.h
+ * @brief The SlotMap template class.
+ *
+ *  This file contains the SlotMap class and template functions.
+ */
+#ifndef DEC_SLOTMAP_H
+#define DEC_SLOTMAP_H
+
+using namespace std;
+
+/**
+ * @brief A stable reference to an item held within a SlotMap. The low 32 bits select a slot and the high 32 bits hold the generation
+ * of that slot, so a handle to a removed item never resolves to whatever reuses the slot. Zero is never a valid handle.
+ */
+typedef uint64_t SlotHandle;
+
+/**
+ * @brief A generational slot map of pointers with constant time insertion and removal and dense iteration.
+ *
+ * Items live in a dense array which is walked by position with SlotMap::Length() and SlotMap::At(). Removing an item blanks its
+ * position straight away, so it is skipped by any loop already underway, but the array itself is only compacted by
+ * SlotMap::Compact() at the end of the pulse. Positions therefore never shift beneath a loop, however deeply loops are nested.
+ */
+template <class T> class SlotMap
+{
+    public:
+        /** @name Core */ /**@{*/
+        const SlotHandle Add( const T& item );
+        const void Compact();
+        const bool Remove( const SlotHandle& handle );
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        T At( const size_t& pos ) const;
+        const bool Empty() const;
+        T Get( const SlotHandle& handle ) const;
+        const size_t Length() const;
+        const size_t Size() const;
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        SlotMap();
+        ~SlotMap();
+        /**@}*/
+
+    private:
+        SlotMap( const SlotMap& );
+        SlotMap& operator=( const SlotMap& );
+
+        vector<T> m_dense; /**< Every item in no particular order. Items removed this pulse are left as T() until SlotMap::Compact(). */
+        vector<uint32_t> m_dense_slot; /**< The slot owning each position of m_dense. */
+        vector<uint32_t> m_free; /**< Slots available for reuse. */
+        vector<size_t> m_removed; /**< Positions within m_dense blanked since the last SlotMap::Compact(). */
+        vector<size_t> m_slot_dense; /**< The position within m_dense of the item held by each slot. */
+        vector<uint32_t> m_slot_generation; /**< The current generation of each slot; odd while the slot holds an item. */
+};
+
+/* Core */
+/**
+ * @brief Add an item to the map.
+ * @param[in] item The item to be added.
+ * @retval SlotHandle A handle which resolves to item until it is removed.
+ */
+template <class T> const SlotHandle SlotMap<T>::Add( const T& item )
+{
+    uint32_t slot = 0;
+
+    if ( m_free.empty() )
+    {
+        slot = m_slot_generation.size();
+        m_slot_generation.push_back( 0 );
+        m_slot_dense.push_back( 0 );
+    }
+    else
+    {
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+
+    // Occupied slots have an odd generation, so a handle is never zero
+    m_slot_generation[slot]++;
+    m_slot_dense[slot] = m_dense.size();
+    m_dense.push_back( item );
+    m_dense_slot.push_back( slot );
+
+    return ( static_cast<SlotHandle>( m_slot_generation[slot] ) << 32 ) | slot;
+}
+
+/**
+ * @brief Close the gaps left by items removed since the last call by moving the last item into each gap. Must not be called while the
+ * map is being walked; the end of the pulse is the intended place.
+ * @retval void
+ */
+template <class T> const void SlotMap<T>::Compact()
+{
+    typename vector<size_t>::iterator ri;
+    size_t last = 0;
+
+    if ( m_removed.empty() )
+        return;
+
+    // Working from the back means every position after the one being filled has already been dealt with, so the last item is live
+    sort( m_removed.begin(), m_removed.end(), greater<size_t>() );
+
+    for ( ri = m_removed.begin(); ri != m_removed.end(); ri++ )
+    {
+        last = m_dense.size() - 1;
+        m_free.push_back( m_dense_slot[*ri] );
+
+        if ( *ri != last )
+        {
+            m_dense[*ri] = m_dense[last];
+            m_dense_slot[*ri] = m_dense_slot[last];
+            m_slot_dense[m_dense_slot[*ri]] = *ri;
+        }
+
+        m_dense.pop_back();
+        m_dense_slot.pop_back();
+    }
+
+    m_removed.clear();
+
+    return;
+}
+
+/**
+ * @brief Remove an item from the map. The item can no longer be reached by its handle or seen by a walk of the map.
+ * @param[in] handle The handle returned by SlotMap::Add().
+ * @retval false Returned if the handle does not refer to an item within the map.
+ * @retval true Returned if the item was removed.
+ */
+template <class T> const bool SlotMap<T>::Remove( const SlotHandle& handle )
+{
+    uint32_t slot = static_cast<uint32_t>( handle );
+
+    if ( Get( handle ) == T() )
+        return false;
+
+    // The slot stays out of m_free until SlotMap::Compact() so its position in m_dense can't be handed out twice
+    m_slot_generation[slot]++;
+    m_dense[m_slot_dense[slot]] = T();
+    m_removed.push_back( m_slot_dense[slot] );
+
+    return true;
+}
+
+/* Query */
+/**
+ * @brief Returns the item at a position within the dense array, for walking the map from 0 to SlotMap::Length().
+ * @param[in] pos The position within the dense array.
+ * @retval T The item at pos, or T() if the item there was removed during this pulse.
+ */
+template <class T> T SlotMap<T>::At( const size_t& pos ) const
+{
+    if ( pos >= m_dense.size() )
+        return T();
+
+    return m_dense[pos];
+}
+
+/**
+ * @brief Tests if the map holds no items.
+ * @retval false Returned if there is at least one item within the map.
+ * @retval true Returned if there are no items within the map.
+ */
+template <class T> const bool SlotMap<T>::Empty() const
+{
+    return Size() == 0;
+}
+
+/**
+ * @brief Resolves a handle to its item.
+ * @param[in] handle The handle returned by SlotMap::Add().
+ * @retval T The item referred to by handle, or T() if it has since been removed.
+ */
+template <class T> T SlotMap<T>::Get( const SlotHandle& handle ) const
+{
+    uint32_t slot = static_cast<uint32_t>( handle );
+
+    if ( slot >= m_slot_generation.size() || m_slot_generation[slot] != static_cast<uint32_t>( handle >> 32 ) )
+        return T();
+
+    return m_dense[m_slot_dense[slot]];
+}
+
+/**
+ * @brief Returns the length of the dense array, including any positions blanked during this pulse.
+ * @retval size_t The bound for walking the map with SlotMap::At().
+ */
+template <class T> const size_t SlotMap<T>::Length() const
+{
+    return m_dense.size();
+}
+
+/**
+ * @brief Returns the number of items within the map.
+ * @retval size_t The number of items within the map.
+ */
+template <class T> const size_t SlotMap<T>::Size() const
+{
+    return m_dense.size() - m_removed.size();
+}
+
+/* Manipulate */
+
+/* Internal */
+/**
+ * @brief Constructor for the SlotMap class.
+ */
+template <class T> SlotMap<T>::SlotMap()
+{
+    m_dense.clear();
+    m_dense_slot.clear();
+    m_free.clear();
+    m_removed.clear();
+    m_slot_dense.clear();
+    m_slot_generation.clear();
+
+    return;
+}
+
+/**
+ * @brief Destructor for the SlotMap class. The items themselves are not deleted.
+ */
+template <class T> SlotMap<T>::~SlotMap()
+{
+    return;
+}
+
+#endif
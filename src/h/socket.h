@@ -51,16 +51,21 @@ class Socket
         /**@}*/
 
         /** @name Query */ /**@{*/
+        const uint_t gBytesCompressed() const;
         const uint_t gBytesRecvd() const;
         const uint_t gBytesSent() const;
+        const uint_t gBytesUncompressed() const;
         const sint_t gDescriptor() const;
         const string gHostname() const;
         const uint_t gPort() const;
         /**@}*/
 
         /** @name Manipulate */ /**@{*/
+        const bool aBytesCompressed( const uint_t& amount );
         const bool aBytesRecvd( const uint_t& amount );
         const bool aBytesSent( const uint_t& amount );
+        const bool aBytesUncompressed( const uint_t& amount );
+        const bool sCloseOnExec( const bool& val );
         const bool sDescriptor( const sint_t& descriptor );
         const bool sHostname( const string& hostname );
         const bool sPort( const uint_t& port );
@@ -72,8 +77,10 @@ class Socket
         /**@}*/
 
     private:
-        uint_t m_bytes_recvd; /**< Number of bytes received. */
-        uint_t m_bytes_sent; /**< Number of bytes sent. */
+        atomic<uint_t> m_bytes_compressed; /**< Number of bytes of compressed output produced for sending. Updated by the I/O threads. */
+        atomic<uint_t> m_bytes_recvd; /**< Number of bytes received. Updated by the I/O threads. */
+        atomic<uint_t> m_bytes_sent; /**< Number of bytes sent. Updated by the I/O threads. */
+        atomic<uint_t> m_bytes_uncompressed; /**< Number of bytes of output passed through compression, before compressing. Updated by the I/O threads. */
         sint_t m_descriptor; /**< File descriptor assigned from the host OS. */
         string m_hostname; /**< Hostname of the host OS or remote client. */
         uint_t m_port; /**< Port number being used. */
@@ -62,11 +62,27 @@ class SocketClient : public Socket
             bool m_telopt[MAX_SOC_TELOPT]; /**< Supported telnet options. */
     };
 
+    /**
+     * @brief A command waiting in the queue along with the Command it was resolved to, so that it is only looked up once.
+     */
+    class QueuedCommand
+    {
+        public:
+            string m_args; /**< Arguments to be passed to the command. */
+            string m_cmd; /**< The command as received from the client. */
+            Command* m_command; /**< The Command that m_cmd resolved to when queued, or NULL if there was no match. */
+            uint_t m_revision; /**< Value of Server::Global::m_command_revision when m_command was resolved. */
+    };
+
     public:
         /** @name Core */ /**@{*/
+        const bool Closing() const;
+        const bool Deflate( const char* data, const uint_t& length, const sint_t& mode, string& output );
         const void Delete();
+        const bool Flush();
         const bool New( const sint_t& descriptor, const bool& reboot = false );
         const bool PendingCommand() const;
+        const bool PendingPreempt() const;
         const bool PendingOutput() const;
         const bool ProcessCommand();
         const bool ProcessInput();
@@ -77,23 +93,40 @@ class SocketClient : public Socket
         const void ResolveHostname();
         const bool Send();
         const bool Send( const string& msg );
+        const bool Send( const Segment& msg );
         const string Serialize() const;
         /**@}*/
 
         /** @name Query */ /**@{*/
         Account* gAccount() const;
+        const uint_t gCommandsRun() const;
+        const bool gCompress() const;
+        list<Event*>* gEvents();
+        const bool gHangup() const;
         const uint_t gIdle() const;
+        const bool gInputLimited() const;
+        const SlotHandle gListHandle() const;
         const string gLogin( const uint_t& key ) const;
+        const bool gOutputPending() const;
         const uint_t gState() const;
+        const char gTelnetCommand() const;
+        const uint_t gTelnetState() const;
         SocketClient::TermInfo* gTermInfo() const;
+        const bool gThrottled() const;
         /**@}*/
 
         /** @name Manipulate */ /**@{*/
+        const void aInput( const uint_t& type, const string& input );
+        const void aInput( const uint_t& type, const char* data, const uint_t& length );
         const bool sAccount( Account* account );
+        const bool sCompress( const bool& val, string& output );
+        const void sHangup( const bool& val );
         const bool sIdle( const uint_t& idle );
         const bool sLogin( const uint_t& key, const string& val);
-        static void* tResolveHostname( void* data );
+        const void sOutputPending( const bool& val );
         const bool sState( const uint_t& state );
+        const void sTelnetState( const uint_t& state, const char& cmd );
+        const void sWritable( const bool& val );
         /**@}*/
 
         /** @name Internal */ /**@{*/
@@ -103,14 +136,40 @@ class SocketClient : public Socket
 
     private:
         Account* m_account; /**< The account associated with the client. */
-        deque< pair<string,string> > m_command_queue; /**< FIFO queue for commands unless the command specifies preempt. */
-        uint_t m_idle; /**< Amount of time since data was last received from the client. */
-        string m_input; /**< Data received from the client that hasn't been processed yet. */
+        bool m_closing; /**< Set once the client has been deleted and is waiting on its IOThread to finish with it. */
+        uint_t m_command_preempt; /**< Number of preempt commands at the front of m_command_queue. */
+        deque<SocketClient::QueuedCommand> m_command_queue; /**< FIFO queue for commands unless the command specifies preempt. */
+        uint_t m_command_refill; /**< Pulse on which m_command_tokens was last refilled. */
+        uint_t m_command_tokens; /**< Commands which may be accepted before #CFG_SOC_INPUT_COMMAND_RATE applies, scaled by #CFG_GAM_PULSE_RATE. */
+        uint_t m_commands_run; /**< Number of commands from m_command_queue run during m_last_command. */
+        z_stream* m_deflate; /**< The MCCP2 compression stream, or NULL while output is sent uncompressed. Only accessed by the I/O thread. */
+        list<Event*> m_events; /**< Pending events initiated by the client. */
+        bool m_hangup; /**< Set once the connection has failed or been closed. Only accessed by the I/O thread. */
+        string m_input; /**< Data received from the client that hasn't been split into lines yet, including any partial line left by the last read. Only accessed by the I/O thread. */
+        bool m_input_limited; /**< Set once m_input_tokens runs out with data possibly left unread in the kernel. Only accessed by the I/O thread. */
+        bool m_input_overflow; /**< Set while commands are being dropped, so that the client is only warned once per flood. */
+        chrono::steady_clock::time_point m_input_refill; /**< Time at which m_input_tokens was last refilled. Only accessed by the I/O thread. */
+        uint_t m_input_tokens; /**< Bytes which may be read before #CFG_SOC_INPUT_BYTE_RATE applies. Only accessed by the I/O thread. */
+        SPSCQueue< pair<uint_t,string> > m_input_queue; /**< Lines and telnet negotiations from the I/O thread to the game thread, typed from #SOC_INPUT. */
+        IOThread* m_io_thread; /**< The IOThread which owns the socket. */
+        uint_t m_last_command; /**< Pulse on which a command from m_command_queue was last run. */
+        sint_t m_last_input; /**< Pulse on which data was last received from the client. */
+        SlotHandle m_list_handle; /**< Where the client is held within #socket_client_list. Stays valid only while the client does. */
         string m_login[MAX_SOC_LOGIN]; /**< Used to pass login process commands and arguments between handler functions. */
-        string m_output; /**< Data buffered for sending to the client. */
+        string m_output; /**< Data buffered for sending to the client alone during the current pulse, not yet closed off into m_output_chain. Only accessed by the game thread. */
+        vector<Segment> m_output_chain; /**< Segments, private and shared, buffered for sending to the client during the current pulse. Only accessed by the game thread. */
+        bool m_output_pending; /**< Flag the client as already present within socket_client_output_list. */
+        SPSCQueue< vector<Segment> > m_output_queue; /**< Output from the game thread to the I/O thread, one chain of segments per pulse. */
         bool m_quitting; /**< Flag the client as quitting to escape nested loops. */
         uint_t m_state; /**< Connection state of the client from #SOC_STATE. */
+        char m_telnet_cmd; /**< The telnet command awaiting its option byte while m_telnet_state is #SOC_TELNET_OPTION. Only accessed by the I/O thread. */
+        uint_t m_telnet_state; /**< Telnet parser state from #SOC_TELNET, carried between reads so sequences may be split across them. Only accessed by the I/O thread. */
         SocketClient::TermInfo* m_terminfo; /**< Terminal options and status. */
+        atomic<bool> m_throttled; /**< Set by the I/O thread while unsent output is above #CFG_SOC_OUTPUT_HIGH_WATER; input is neither read nor run. */
+        bool m_writable; /**< False if the last write filled the kernel send buffer; cleared until the reactor reports the socket writable again. Only accessed by the I/O thread. */
+        deque<Segment> m_write_buffer; /**< Segments of output taken from m_output_queue which haven't been fully written to the socket yet. Only accessed by the I/O thread. */
+        uint_t m_write_offset; /**< Number of bytes of the front segment of m_write_buffer which have already been written. Only accessed by the I/O thread. */
+        uint_t m_write_size; /**< Total number of unwritten bytes within m_write_buffer. Only accessed by the I/O thread. */
 };
 
 #endif
@@ -44,9 +44,11 @@ class SocketServer : public Socket
         /**@}*/
 
         /** @name Query */ /**@{*/
+        const bool gPaused() const;
         /**@}*/
 
         /** @name Manipulate */ /**@{*/
+        const bool sPaused( const bool& val );
         /**@}*/
 
         /** @name Internal */ /**@{*/
@@ -55,6 +57,9 @@ class SocketServer : public Socket
         /**@}*/
 
     private:
+        uint_t m_accept_pulse; /**< The pulse that m_accepted was counted during. */
+        uint_t m_accepted; /**< Number of connections accepted during m_accept_pulse. */
+        bool m_paused; /**< Set once the accept budget for a pulse is spent. */
 };
 
 #endif
@@ -0,0 +1,197 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file spscqueue.h
+ * @brief The SPSCQueue template class.
+ *
+ *  This file contains the SPSCQueue class and template functions.
+ */
+#ifndef DEC_SPSCQUEUE_H
+#define DEC_SPSCQUEUE_H
+
+using namespace std;
+
+/**
+ * @brief An unbounded, lock-free queue for handing items from exactly one producer thread to exactly one consumer thread.
+ *
+ * The queue always holds one consumed node at its head. The producer only ever touches the tail and the consumer only ever
+ * touches the head, so the single atomic link between nodes is the only thing the two threads share.
+ */
+template <class T> class SPSCQueue
+{
+    public:
+        /** @name Core */ /**@{*/
+        const bool Pop( T& item );
+        const void Push( const T& item );
+        const void Push( T&& item );
+        /**@}*/
+
+        /** @name Query */ /**@{*/
+        const bool Empty() const;
+        /**@}*/
+
+        /** @name Manipulate */ /**@{*/
+        /**@}*/
+
+        /** @name Internal */ /**@{*/
+        SPSCQueue();
+        ~SPSCQueue();
+        /**@}*/
+
+    private:
+        /**
+         * @brief A single link within the queue.
+         */
+        class Node
+        {
+            public:
+                /** @name Internal */ /**@{*/
+                Node();
+                ~Node();
+                /**@}*/
+
+                T m_item; /**< The queued item. */
+                atomic<Node*> m_next; /**< The next node within the queue, or NULL if this is the tail. */
+        };
+
+        SPSCQueue( const SPSCQueue& );
+        SPSCQueue& operator=( const SPSCQueue& );
+
+        Node* m_head; /**< The most recently consumed node. Only accessed by the consumer. */
+        Node* m_tail; /**< The most recently produced node. Only accessed by the producer. */
+};
+
+/* Core */
+/**
+ * @brief Remove the item at the front of the queue. May only be called from the consumer thread.
+ * @param[out] item The item that was removed.
+ * @retval false Returned if the queue was empty and item was left untouched.
+ * @retval true Returned if an item was removed.
+ */
+template <class T> const bool SPSCQueue<T>::Pop( T& item )
+{
+    Node* next = m_head->m_next.load( memory_order_acquire );
+
+    if ( next == NULL )
+        return false;
+
+    item = move( next->m_item );
+    delete m_head;
+    m_head = next;
+
+    return true;
+}
+
+/**
+ * @brief Add an item to the back of the queue. May only be called from the producer thread.
+ * @param[in] item The item to be added.
+ * @retval void
+ */
+template <class T> const void SPSCQueue<T>::Push( const T& item )
+{
+    Node* node = new Node();
+
+    node->m_item = item;
+
+    // Publish the fully built node; the release pairs with the acquire within SPSCQueue::Pop()
+    m_tail->m_next.store( node, memory_order_release );
+    m_tail = node;
+
+    return;
+}
+
+/**
+ * @brief Move an item to the back of the queue. May only be called from the producer thread.
+ * @param[in] item The item to be added.
+ * @retval void
+ */
+template <class T> const void SPSCQueue<T>::Push( T&& item )
+{
+    Node* node = new Node();
+
+    node->m_item = move( item );
+
+    // Publish the fully built node; the release pairs with the acquire within SPSCQueue::Pop()
+    m_tail->m_next.store( node, memory_order_release );
+    m_tail = node;
+
+    return;
+}
+
+/* Query */
+/**
+ * @brief Tests if the queue is empty. May only be called from the consumer thread.
+ * @retval false Returned if there is at least one item waiting to be removed.
+ * @retval true Returned if there are no items waiting to be removed.
+ */
+template <class T> const bool SPSCQueue<T>::Empty() const
+{
+    return m_head->m_next.load( memory_order_acquire ) == NULL;
+}
+
+/* Manipulate */
+
+/* Internal */
+/**
+ * @brief Constructor for the SPSCQueue::Node class.
+ */
+template <class T> SPSCQueue<T>::Node::Node()
+{
+    m_item = T();
+    m_next.store( NULL, memory_order_relaxed );
+
+    return;
+}
+
+/**
+ * @brief Destructor for the SPSCQueue::Node class.
+ */
+template <class T> SPSCQueue<T>::Node::~Node()
+{
+    return;
+}
+
+/**
+ * @brief Constructor for the SPSCQueue class.
+ */
+template <class T> SPSCQueue<T>::SPSCQueue()
+{
+    m_head = new Node();
+    m_tail = m_head;
+
+    return;
+}
+
+/**
+ * @brief Destructor for the SPSCQueue class. Neither thread may be using the queue.
+ */
+template <class T> SPSCQueue<T>::~SPSCQueue()
+{
+    Node* node = NULL;
+
+    while ( m_head != NULL )
+    {
+        node = m_head->m_next.load( memory_order_relaxed );
+        delete m_head;
+        m_head = node;
+    }
+
+    return;
+}
+
+#endif
@@ -26,28 +26,41 @@
 #define DEC_SYSINCLUDES_H
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <deque>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <list>
 #include <map>
+#include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #include <arpa/inet.h>
 #include <arpa/telnet.h>
+#include <crypt.h>
 #include <dirent.h>
 #include <dlfcn.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <memory.h>
 #include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <zlib.h>
 
 #endif
@@ -32,11 +32,14 @@ using namespace std;
 namespace Telopt
 {
     /** @name Core */ /**@{*/
+    #define TELOPT_COMPRESS2 86
     #define TELOPT_MSP 90
+    extern const shared_ptr<const string> opt_compress_end;
+    extern const shared_ptr<const string> opt_compress_start;
     static const string opt_telopt_esc = "\e";
     const bool InitialNegotiation( SocketClient* client );
-    const string ProcessInput( SocketClient* client, const string& data );
-    const string ProcessOutput( SocketClient* client, const string& data );
+    const void ProcessInput( SocketClient* client, const char* data, const uint_t& length, string& output );
+    const string ProcessOutput( const string& data );
     /**@}*/
 
     /** @name Query */ /**@{*/
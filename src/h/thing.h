@@ -35,24 +35,35 @@ class Thing
         /** @name Core */ /**@{*/
         const bool AddThing( Thing* thing );
         virtual const void Delete() = 0;
+        static Thing* Find( const string& id, const ThingIndex& index );
+        Thing* FindContent( const string& name, const uint_t& type, const Thing* ignore = NULL ) const;
+        const bool Index( ThingIndex* index );
         virtual const void Interpret( const uint_t& security, const string& cmd, const string& args ) = 0;
         const bool Move( Thing* source, Thing* destination, Exit* exit = NULL );
         const bool RemoveThing( Thing* thing );
         virtual const void Send( const string& msg, Thing* speaker = NULL, Thing* target = NULL ) const;
+        virtual const void Send( const Segment& msg, Thing* speaker = NULL, Thing* target = NULL ) const;
         virtual const bool Serialize() const = 0;
+        const void Unindex();
         virtual const bool Unserialize() = 0;
         /**@}*/
 
         /** @name Query */ /**@{*/
         Brain* gBrain() const;
         Thing* gContainer() const;
-        const vector<Thing*> gContents() const;
+        const uint_t gContentCount() const;
         const string gDescription( const uint_t& type ) const;
+        Thing* gFirstContent() const;
+        const string& gFoldedName() const;
         const string gId() const;
-        const string gLocation() const;
-        const string gName() const;
+        const string& gLocation() const;
+        const Atom gLocationAtom() const;
+        const string& gName() const;
+        const Atom gNameAtom() const;
+        Thing* gNextContent() const;
         const uint_t gType() const;
-        const string gZone() const;
+        const string& gZone() const;
+        const Atom gZoneAtom() const;
         /**@}*/
 
         /** @name Manipulate */ /**@{*/
@@ -61,12 +72,16 @@ class Thing
         const bool sId( const string& id );
         const bool sLocation( const string& location );
         const bool sName( const string& name, const bool& system = false );
+        const bool sName( const Atom& name );
         const bool sType( const uint_t& type );
         const bool sZone( const string& zone );
+        const bool sZone( const Atom& zone );
         /**@}*/
 
         /** @name Internal */ /**@{*/
-        const void NewId( const uint_t& seed );
+        const void AddKeywords( Thing* thing );
+        const void NewId();
+        const void RemoveKeywords( Thing* thing );
         Thing();
         virtual ~Thing();
         /**@}*/
@@ -74,13 +89,21 @@ class Thing
     private:
         Brain* m_brain; /**< The associated Brain. */
         Thing* m_container; /**< The Thing that this Thing is stored within. */
-        vector<Thing*> m_contents; /**< Other Things that are contained within this Thing. */
+        uint_t m_contents_added; /**< Number of Things ever added to the contents, used to number each one as it arrives. */
+        uint_t m_contents_count; /**< Number of Things currently contained within this Thing. */
+        Thing* m_contents_head; /**< The earliest arrival of the Things contained within this Thing. */
+        Thing* m_contents_tail; /**< The latest arrival of the Things contained within this Thing. */
         string m_description[MAX_THING_DESCRIPTION]; /**< What is displayed to other Things. */
         string m_id; /**< An identifier to denote ownership. For characters, id = account.name */
-        string m_location; /**< The location id of where this Thing is located. */
-        string m_name; /**< The name of the thing. */
+        ThingIndex* m_index; /**< The index this Thing is registered within, if any, keyed by m_id. */
+        multimap<string,Thing*>* m_keywords; /**< Each word of the name of every Thing contained within this Thing, as an array indexed by #THING_TYPE. Folded to lowercase if #CFG_GAM_CMD_IGNORE_CASE is set. NULL until something is first contained. */
+        Atom m_location; /**< The location id of where this Thing is located. */
+        Atom m_name; /**< The name of the thing. */
+        uint_t m_order; /**< Where this Thing sits within the contents of its container; lower numbers arrived earlier. */
+        Thing* m_sibling_next; /**< The Thing which arrived in the same container after this Thing. */
+        Thing* m_sibling_prev; /**< The Thing which arrived in the same container before this Thing. */
         uint_t m_type; /**< The inherited sub-type of Thing. */
-        string m_zone; /**< Part of a larger zone / group of locations? Name, if so. */
+        Atom m_zone; /**< Part of a larger zone / group of locations? Name, if so. */
 };
 
 #endif
@@ -48,7 +48,80 @@ namespace Utils
             }
     };
 
+    /**
+     * @brief The FoldedEqual class implements only operator() to compare strings for a ThingIndex, ignoring case if #CFG_GAM_CMD_IGNORE_CASE is set.
+     */
+    class FoldedEqual
+    {
+        public:
+            /**
+             * @brief Compares two strings without copying either.
+             * @param[in] lhs The first string to compare.
+             * @param[in] rhs The second string to compare.
+             * @retval false Returned if the strings differ.
+             * @retval true Returned if the strings are equal.
+             */
+            inline const bool operator() ( const string& lhs, const string& rhs ) const
+            {
+                string::size_type i = 0;
+
+                if ( lhs.length() != rhs.length() )
+                    return false;
+
+                if ( !CFG_GAM_CMD_IGNORE_CASE )
+                    return lhs == rhs;
+
+                for ( i = 0; i < lhs.length(); i++ )
+                    if ( ::tolower( static_cast<unsigned char>( lhs[i] ) ) != ::tolower( static_cast<unsigned char>( rhs[i] ) ) )
+                        return false;
+
+                return true;
+            }
+    };
+
+    /**
+     * @brief The FoldedHash class implements only operator() to hash strings for a ThingIndex, ignoring case if #CFG_GAM_CMD_IGNORE_CASE is set.
+     */
+    class FoldedHash
+    {
+        public:
+            /**
+             * @brief Hashes a string with FNV-1a without copying it.
+             * @param[in] input The string to hash.
+             * @retval size_t The hash of input.
+             */
+            inline const size_t operator() ( const string& input ) const
+            {
+                size_t hash = static_cast<size_t>( 14695981039346656037ULL );
+                string::size_type i = 0;
+
+                for ( i = 0; i < input.length(); i++ )
+                {
+                    hash ^= CFG_GAM_CMD_IGNORE_CASE ? ::tolower( static_cast<unsigned char>( input[i] ) ) : static_cast<unsigned char>( input[i] );
+                    hash *= static_cast<size_t>( 1099511628211ULL );
+                }
+
+                return hash;
+            }
+    };
+
     /** @name Core */ /**@{*/
+    /**
+     * @brief Steps a position past the item it was visiting within a read-only view, such as Location::gExits(), even if that item has
+     * since been removed from the view.
+     * @param[in] items The view being walked.
+     * @param[in,out] pos The position of current within items. It is left alone if current was removed, as the item which followed
+     * current has already moved into its place.
+     * @param[in] current The item that was being visited.
+     * @retval void
+     */
+    template <class T> inline const void Advance( const vector<T>& items, typename vector<T>::size_type& pos, const T& current )
+    {
+        if ( pos < items.size() && items[pos] == current )
+            pos++;
+
+        return;
+    }
     /**
      * @brief Returns a string with all whitespace characters removed.
      * @param[in] t Any type of string to remove whitespace from.
@@ -125,7 +198,6 @@ namespace Utils
     const pair<string,string> ReadPair( const string& input );
     const string ReadString( ifstream& input );
     const string Salt( const string& input );
-    const vector<string> StrNewlines( const string& input );
     const bool StrPrefix( const string& s1, const string& s2, const bool& igncase = false );
     const string StrTime( const time_t& now = chrono::high_resolution_clock::to_time_t( chrono::high_resolution_clock::now() ) );
     const vector<string> StrTokens( const string& input, const bool& quiet = false );
@@ -156,7 +228,6 @@ namespace Utils
     }
     const bool iDirectory( const string& dir );
     const bool iFile( const string& file );
-    const bool iName( const string& name, const string& input );
     const bool iNumber( const string& input );
     const bool iReadable( const string& file );
     /**@}*/
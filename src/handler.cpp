@@ -33,6 +33,7 @@
 #include "h/command.h"
 #include "h/event.h"
 #include "h/exit.h"
+#include "h/hasher.h"
 #include "h/list.h"
 #include "h/location.h"
 #include "h/object.h"
@@ -42,7 +43,8 @@
 /**
  * @brief Locates a Character within the game.
  * @param[in] name The name of the Character to search for.
- * @param[in] type The field to search against, from #HANDLER_FIND.
+ * @param[in] type The field to search against, from #HANDLER_FIND. Exact id searches of #character_template_list are answered from
+ * its index; look up characters within #character_list through #character_index.
  * @param[in] clist The character list to be searched.
  * @retval Character* A pointer to the Character object associated with name, or NULL if one is not found.
  */
@@ -51,6 +53,7 @@ Character* Handler::FindCharacter( const string& name, const uint_t& type, const
     UFLAGS_DE( flags );
     Character* chr = NULL;
     bool found = false;
+    string folded;
     CITER( vector, Character*, ci );
     uint_t search = type;
 
@@ -67,6 +70,22 @@ Character* Handler::FindCharacter( const string& name, const uint_t& type, const
         search = HANDLER_FIND_ID;
     }
 
+    if ( search == HANDLER_FIND_ID )
+    {
+        if ( &clist == &character_template_list )
+            return static_cast<Character*>( Thing::Find( name, character_template_index ) );
+
+        // Not a list with an index of its own, so match the whole id the slow way
+        for ( ci = clist.begin(); ci != clist.end(); ci++ )
+            if ( Utils::FoldedEqual()( ( *ci )->gId(), name ) )
+                return *ci;
+
+        return NULL;
+    }
+
+    // Fold the search term once rather than once per candidate
+    folded = CFG_GAM_CMD_IGNORE_CASE ? Utils::Lower( name ) : name;
+
     for ( ci = clist.begin(); ci != clist.end(); ci++ )
     {
         found = false;
@@ -74,14 +93,14 @@ Character* Handler::FindCharacter( const string& name, const uint_t& type, const
 
         if ( CFG_GAM_CMD_IGNORE_CASE )
         {
-            if ( search == HANDLER_FIND_ID && Utils::Lower( chr->gId() ).find( Utils::Lower( name ) ) == 0 )
+            if ( search == HANDLER_FIND_ID_PREFIX && Utils::Lower( chr->gId() ).find( folded ) == 0 )
                 found = true;
-            else if ( search == HANDLER_FIND_NAME && Utils::Lower( chr->gName() ).find( Utils::Lower( name ) ) == 0 )
+            else if ( search == HANDLER_FIND_NAME && chr->gFoldedName().find( folded ) == 0 )
                 found = true;
         }
         else
         {
-            if ( search == HANDLER_FIND_ID && chr->gId().find( name ) == 0 )
+            if ( search == HANDLER_FIND_ID_PREFIX && chr->gId().find( name ) == 0 )
                 found = true;
             else if ( search == HANDLER_FIND_NAME && chr->gName().find( name ) == 0 )
                 found = true;
@@ -98,50 +117,53 @@ Character* Handler::FindCharacter( const string& name, const uint_t& type, const
 }
 
 /**
- * @brief Locates a Command associated with the game.
- * @param[in] name The name of the Command to search for.
+ * @brief Locates a Command associated with the game. Where name abbreviates several commands, the first in alphabetical order is returned.
+ * @param[in] name The name, or an abbreviation of the name, of the Command to search for.
  * @retval Command* A pointer to the Command object associated with name, or NULL if one is not found.
  */
 Command* Handler::FindCommand( const string& name )
 {
     UFLAGS_DE( flags );
-    Command* cmd = NULL;
+    uint_t low = 0, high = command_index.size(), mid = 0;
+    string::size_type i = 0;
+    unsigned char key = 0, search = 0;
     bool found = false;
-    ITER( vector, Command*, vi );
 
     if ( name.empty() )
     {
         LOGSTR( flags, "Handler::FindCommand()-> called with empty name" );
-        return cmd;
+        return NULL;
     }
 
-    if ( command_list.empty() )
-        return cmd;
-
-    for ( vi = command_list.begin(); vi != command_list.end(); vi++ )
+    // Binary search for the first name in the index not ordered before the one given, folding its case as it is compared
+    while ( low < high )
     {
-        found = false;
-        cmd = *vi;
+        mid = low + ( high - low ) / 2;
 
-        if ( CFG_GAM_CMD_IGNORE_CASE )
+        for ( i = 0; i < name.length() && i < command_index[mid].first.length(); i++ )
         {
-            if ( Utils::Lower( cmd->gName() ).find( Utils::Lower( name ) ) == 0 )
-                found = true;
+            key = command_index[mid].first[i];
+            search = CFG_GAM_CMD_IGNORE_CASE ? ::tolower( static_cast<unsigned char>( name[i] ) ) : name[i];
+
+            if ( key != search )
+                break;
         }
-        else
+
+        // Either name abbreviates this entry or this entry is ordered after it; the answer lies no further right
+        if ( i == name.length() || ( i < command_index[mid].first.length() && key > search ) )
         {
-            if ( cmd->gName().find( name ) == 0 )
-                found = true;
+            high = mid;
+            found = ( i == name.length() );
         }
-
-        if ( found )
-            break;
+        else
+            low = mid + 1;
     }
 
+    // The first name that name abbreviates, if any, is where the search settled
     if ( !found )
-        cmd = NULL;
+        return NULL;
 
-    return cmd;
+    return command_index[high].second;
 }
 
 /**
@@ -154,8 +176,7 @@ Exit* Handler::FindExit( const string& name, Location* location )
 {
     UFLAGS_DE( flags );
     Exit* exit = NULL;
-    vector<Exit*> loc_exits;
-    ITER( vector, Exit*, ei );
+    CITER( vector, Exit*, ei );
     bool found = false;
 
     if ( name.empty() )
@@ -176,12 +197,10 @@ Exit* Handler::FindExit( const string& name, Location* location )
         return exit;
     }
 
-    loc_exits = location->gExits();
-
-    if ( loc_exits.empty() )
+    if ( location->gExits().empty() )
         return exit;
 
-    for ( ei = loc_exits.begin(); ei != loc_exits.end(); ei++ )
+    for ( ei = location->gExits().begin(); ei != location->gExits().end(); ei++ )
     {
         found = false;
         exit = *ei;
@@ -210,7 +229,7 @@ Exit* Handler::FindExit( const string& name, Location* location )
 /**
  * @brief Locates a Location associated with the game.
  * @param[in] name The name of the Location to search for.
- * @param[in] type The field to search against, from #HANDLER_FIND.
+ * @param[in] type The field to search against, from #HANDLER_FIND. Exact id searches are answered from #location_index.
  * @retval Location* A pointer to the Location object associated with name, or NULL if one is not found.
  */
 Location* Handler::FindLocation( const string& name, const uint_t& type )
@@ -218,6 +237,7 @@ Location* Handler::FindLocation( const string& name, const uint_t& type )
     UFLAGS_DE( flags );
     Location* loc = NULL;
     bool found = false;
+    string folded;
     ITER( vector, Location*, li );
     uint_t search = type;
 
@@ -237,6 +257,12 @@ Location* Handler::FindLocation( const string& name, const uint_t& type )
         search = HANDLER_FIND_ID;
     }
 
+    if ( search == HANDLER_FIND_ID )
+        return static_cast<Location*>( Thing::Find( name, location_index ) );
+
+    // Fold the search term once rather than once per candidate
+    folded = CFG_GAM_CMD_IGNORE_CASE ? Utils::Lower( name ) : name;
+
     for ( li = location_list.begin(); li != location_list.end(); li++ )
     {
         found = false;
@@ -244,14 +270,14 @@ Location* Handler::FindLocation( const string& name, const uint_t& type )
 
         if ( CFG_GAM_CMD_IGNORE_CASE )
         {
-            if ( search == HANDLER_FIND_ID && Utils::Lower( loc->gId() ).find( Utils::Lower( name ) ) == 0 )
+            if ( search == HANDLER_FIND_ID_PREFIX && Utils::Lower( loc->gId() ).find( folded ) == 0 )
                 found = true;
-            else if ( search == HANDLER_FIND_NAME && Utils::Lower( loc->gName() ).find( Utils::Lower( name ) ) == 0 )
+            else if ( search == HANDLER_FIND_NAME && loc->gFoldedName().find( folded ) == 0 )
                 found = true;
         }
         else
         {
-            if ( search == HANDLER_FIND_ID && loc->gId().find( name ) == 0 )
+            if ( search == HANDLER_FIND_ID_PREFIX && loc->gId().find( name ) == 0 )
                 found = true;
             else if ( search == HANDLER_FIND_NAME && loc->gName().find( name ) == 0 )
                 found = true;
@@ -270,7 +296,8 @@ Location* Handler::FindLocation( const string& name, const uint_t& type )
 /**
  * @brief Locates an Object associated with the game.
  * @param[in] name The name of the Object to search for.
- * @param[in] type The field to search against, from #HANDLER_FIND.
+ * @param[in] type The field to search against, from #HANDLER_FIND. Exact id searches of #object_template_list are answered from
+ * its index; look up objects within #object_list through #object_index.
  * @param[in] olist The object list to be searched.
  * @retval Object* A pointer to the Object object associated with name, or NULL if one is not found.
  */
@@ -279,6 +306,7 @@ Object* Handler::FindObject( const string& name, const uint_t& type, const vecto
     UFLAGS_DE( flags );
     Object* obj = NULL;
     bool found = false;
+    string folded;
     CITER( vector, Object*, oi );
     uint_t search = type;
 
@@ -298,6 +326,22 @@ Object* Handler::FindObject( const string& name, const uint_t& type, const vecto
         search = HANDLER_FIND_ID;
     }
 
+    if ( search == HANDLER_FIND_ID )
+    {
+        if ( &olist == &object_template_list )
+            return static_cast<Object*>( Thing::Find( name, object_template_index ) );
+
+        // Not a list with an index of its own, so match the whole id the slow way
+        for ( oi = olist.begin(); oi != olist.end(); oi++ )
+            if ( Utils::FoldedEqual()( ( *oi )->gId(), name ) )
+                return *oi;
+
+        return NULL;
+    }
+
+    // Fold the search term once rather than once per candidate
+    folded = CFG_GAM_CMD_IGNORE_CASE ? Utils::Lower( name ) : name;
+
     for ( oi = olist.begin(); oi != olist.end(); oi++ )
     {
         found = false;
@@ -305,14 +349,14 @@ Object* Handler::FindObject( const string& name, const uint_t& type, const vecto
 
         if ( CFG_GAM_CMD_IGNORE_CASE )
         {
-            if ( search == HANDLER_FIND_ID && Utils::Lower( obj->gId() ).find( Utils::Lower( name ) ) == 0 )
+            if ( search == HANDLER_FIND_ID_PREFIX && Utils::Lower( obj->gId() ).find( folded ) == 0 )
                 found = true;
-            else if ( search == HANDLER_FIND_NAME && Utils::Lower( obj->gName() ).find( Utils::Lower( name ) ) == 0 )
+            else if ( search == HANDLER_FIND_NAME && obj->gFoldedName().find( folded ) == 0 )
                 found = true;
         }
         else
         {
-            if ( search == HANDLER_FIND_ID && obj->gId().find( name ) == 0 )
+            if ( search == HANDLER_FIND_ID_PREFIX && obj->gId().find( name ) == 0 )
                 found = true;
             else if ( search == HANDLER_FIND_NAME && obj->gName().find( name ) == 0 )
                 found = true;
@@ -342,8 +386,6 @@ Thing* Handler::FindThing( const string& name, const uint_t& type, const uint_t&
     UFLAGS_DE( flags );
     bool found = false;
     Thing* thing = NULL;
-    vector<Thing*> targets;
-    CITER( vector, Thing*, ti );
     uint_t ltype = type, lscope = scope;
 
     if ( name.empty() )
@@ -375,24 +417,8 @@ Thing* Handler::FindThing( const string& name, const uint_t& type, const uint_t&
     switch ( lscope )
     {
         case HANDLER_SCOPE_INVENTORY:
-            targets = caller->gContents();
-            for ( ti = targets.begin(); ti != targets.end(); ti++ )
-            {
-                thing = *ti;
-
-                // Shouldn't ever happen anyways...
-                if ( thing == caller && !self )
-                    continue;
-
-                if ( thing->gType() != ltype )
-                    continue;
-
-                if ( Utils::iName( name, thing->gName() ) )
-                {
-                    found = true;
-                    break;
-                }
-            }
+            if ( ( thing = caller->FindContent( name, ltype, self ? NULL : caller ) ) != NULL )
+                found = true;
         break;
 
         case HANDLER_SCOPE_LOCATION:
@@ -402,24 +428,8 @@ Thing* Handler::FindThing( const string& name, const uint_t& type, const uint_t&
                 return thing;
             }
 
-            targets = caller->gContainer()->gContents();
-            for ( ti = targets.begin(); ti != targets.end(); ti++ )
-            {
-                thing = *ti;
-
-                // Shouldn't ever happen anyways...
-                if ( thing == caller && !self )
-                    continue;
-
-                if ( thing->gType() != ltype )
-                    continue;
-
-                if ( Utils::iName( name, thing->gName() ) )
-                {
-                    found = true;
-                    break;
-                }
-            }
+            if ( ( thing = caller->gContainer()->FindContent( name, ltype, self ? NULL : caller ) ) != NULL )
+                found = true;
         break;
 
         case HANDLER_SCOPE_LOC_INV:
@@ -497,8 +507,8 @@ const bool Handler::CheckCreating( SocketClient* client, const string& name )
 {
     UFLAGS_DE( flags );
     UFLAGS_S( flag );
-    ITER( vector, SocketClient*, si );
     SocketClient* socket_client = NULL;
+    size_t i = 0;
 
     if ( client == NULL )
     {
@@ -512,12 +522,9 @@ const bool Handler::CheckCreating( SocketClient* client, const string& name )
         return false;
     }
 
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
+    for ( i = 0; i < socket_client_list.Length(); i++ )
     {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
-
-        if ( socket_client == client )
+        if ( ( socket_client = socket_client_list.At( i ) ) == NULL || socket_client == client )
             continue;
 
         if ( socket_client->gState() >= SOC_STATE_ACCOUNT_MENU )
@@ -542,8 +549,6 @@ const bool Handler::CheckCreating( SocketClient* client, const string& name )
 const bool Handler::CheckPlaying( const string& name )
 {
     UFLAGS_DE( flags );
-    UFLAGS_S( flag );
-    ITER( vector, Character*, ci );
     Character* chr = NULL;
 
     if ( name.empty() )
@@ -552,15 +557,9 @@ const bool Handler::CheckPlaying( const string& name )
         return false;
     }
 
-    /** @todo Change this to use FindCharacter()? */
-    for ( ci = character_list.begin(); ci != character_list.end(); ci = g_global->m_next_character )
-    {
-        chr = *ci;
-        g_global->m_next_character = ++ci;
-
-        if ( chr->gId() == name )
-            return true;
-    }
+    // The index may ignore case, but a playing Character must match exactly
+    if ( ( chr = static_cast<Character*>( Thing::Find( name, character_index ) ) ) != NULL && chr->gId() == name )
+        return true;
 
     return false;
 }
@@ -723,9 +722,7 @@ const void Handler::Reconnect( SocketClient* client, Character* character )
 {
     UFLAGS_DE( flags );
     UFLAGS_S( flag );
-    ITER( vector, Event*, ei );
-    ITER( vector, Event*, ei_next );
-    Event* event = NULL;
+    Command* command = NULL;
 
     if ( client == NULL )
     {
@@ -755,21 +752,125 @@ const void Handler::Reconnect( SocketClient* client, Character* character )
     client->gAccount()->sCharacter( character );
 
     // Cleanup any pending disconnection events from the old Character
-    for ( ei = event_list.begin(); ei != event_list.end(); ei = g_global->m_next_event )
+    if ( ( command = Handler::FindCommand( "quit" ) ) != NULL )
+        Event::Cancel( character->gEvents(), command );
+
+    client->sState( SOC_STATE_PLAYING );
+    client->Send( CFG_STR_CHR_RECONNECTED );
+
+    return;
+}
+
+/**
+ * @brief Resume the login of a client once the password it sent has been hashed.
+ * @param[in] client The SocketClient the password was received from.
+ * @param[in] state The state from #SOC_STATE the SocketClient was in when it sent the password.
+ * @param[in] hash The hashed password, or empty if it was unable to be hashed.
+ * @retval void
+ */
+const void Handler::PasswordVerified( SocketClient* client, const uint_t& state, const string& hash )
+{
+    UFLAGS_DE( flags );
+
+    if ( client == NULL )
+    {
+        LOGSTR( flags, "Handler::PasswordVerified()-> called with NULL client" );
+        return;
+    }
+
+    if ( client->gState() != SOC_STATE_VERIFYING )
     {
-        event = *ei;
-        g_global->m_next_event = ++ei;
+        LOGFMT( flags, "Handler::PasswordVerified()-> called with invalid client state: %lu", client->gState() );
+        return;
+    }
 
-        if ( event->gCharacter() == character && event->gCommand() == Handler::FindCommand( "quit" ) )
-            event->Delete();
+    client->sState( state );
+
+    if ( hash.empty() )
+    {
+        LOGFMT( flags, "Handler::PasswordVerified()-> unable to hash password for account %s", CSTR( client->gLogin( SOC_LOGIN_NAME ) ) );
+        client->sLogin( SOC_LOGIN_PASSWORD, "" );
+        client->Send( CFG_STR_ACT_PASSWORD_GET );
+
+        return;
     }
 
-    client->sState( SOC_STATE_PLAYING );
-    client->Send( CFG_STR_CHR_RECONNECTED );
+    switch ( state )
+    {
+        // Compared against the stored password once the account is loaded
+        case SOC_STATE_GET_OLD_PASSWORD:
+            client->sLogin( SOC_LOGIN_PASSWORD, hash );
+            client->sState( SOC_STATE_LOAD_ACCOUNT );
+        break;
+
+        case SOC_STATE_GET_NEW_PASSWORD:
+            if ( client->gLogin( SOC_LOGIN_PASSWORD ).empty() )
+            {
+                client->sLogin( SOC_LOGIN_PASSWORD, hash );
+                client->Send( CFG_STR_ACT_PASSWORD_CONFIRM );
+
+                return;
+            }
+
+            if ( hash == client->gLogin( SOC_LOGIN_PASSWORD ) )
+                client->sState( SOC_STATE_CREATE_ACCOUNT );
+            else
+            {
+                client->sLogin( SOC_LOGIN_PASSWORD, "" );
+                client->Send( CFG_STR_ACT_PASSWORD_MISMATCH );
+                client->Send( CFG_STR_ACT_PASSWORD_GET );
+
+                return;
+            }
+        break;
+
+        default:
+            LOGFMT( flags, "Handler::PasswordVerified()-> called with invalid state: %lu", state );
+        return;
+    }
+
+    //Generate the next input prompt
+    LoginHandler( client );
 
     return;
 }
 
+/**
+ * @brief Hand a password to the Hasher and park the client in #SOC_STATE_VERIFYING until Handler::PasswordVerified() is called.
+ * @param[in] client The SocketClient the password was received from.
+ * @param[in] password The password to be hashed.
+ * @retval false Returned if the password was refused because too many from the same host are already being verified.
+ * @retval true Returned if the password was queued to be hashed.
+ */
+const bool Handler::VerifyPassword( SocketClient* client, const string& password )
+{
+    UFLAGS_DE( flags );
+    static Hasher::Job job_zero;
+    Hasher::Job job = job_zero;
+
+    if ( client == NULL )
+    {
+        LOGSTR( flags, "Handler::VerifyPassword()-> called with NULL client" );
+        return false;
+    }
+
+    job.m_handle = client->gListHandle();
+    job.m_host = client->gHostname();
+    job.m_password = password;
+    job.m_salt = Utils::Salt( client->gLogin( SOC_LOGIN_NAME ) );
+    job.m_state = client->gState();
+
+    if ( !g_global->m_hasher->Hash( job ) )
+    {
+        client->Send( CFG_STR_ACT_PASSWORD_BUSY );
+        return false;
+    }
+
+    client->sState( SOC_STATE_VERIFYING );
+
+    return true;
+}
+
 /* Internal */
 /**
  * @brief Send initial account interface menu.
@@ -1492,27 +1593,9 @@ const void Handler::GetNewPassword( SocketClient* client, const string& cmd, con
         return;
     }
 
-    if ( client->gLogin( SOC_LOGIN_PASSWORD ).empty() )
-    {
-        client->sLogin( SOC_LOGIN_PASSWORD, ::crypt( CSTR( cmd ), CSTR( Utils::Salt( client->gLogin( SOC_LOGIN_NAME ) ) ) ) );
-        client->Send( CFG_STR_ACT_PASSWORD_CONFIRM );
-
-        return;
-    }
-
-    if ( CKPASSWORD( client->gLogin( SOC_LOGIN_NAME ), cmd, client->gLogin( SOC_LOGIN_PASSWORD ) ) )
-        client->sState( SOC_STATE_CREATE_ACCOUNT );
-    else
-    {
-        client->sLogin( SOC_LOGIN_PASSWORD, "" );
-        client->Send( CFG_STR_ACT_PASSWORD_MISMATCH );
-        client->Send( CFG_STR_ACT_PASSWORD_GET );
-
-        return;
-    }
-
-    //Generate the next input prompt
-    LoginHandler( client );
+    // Both the initial entry and its confirmation are hashed off the game thread; Handler::PasswordVerified() resumes from here
+    if ( !VerifyPassword( client, cmd ) )
+        client->Send( client->gLogin( SOC_LOGIN_PASSWORD ).empty() ? CFG_STR_ACT_PASSWORD_GET : CFG_STR_ACT_PASSWORD_CONFIRM );
 
     return;
 }
@@ -1542,11 +1625,9 @@ const void Handler::GetOldPassword( SocketClient* client, const string& cmd, con
         return;
     }
 
-    client->sLogin( SOC_LOGIN_PASSWORD, ::crypt( CSTR( cmd ), CSTR( Utils::Salt( client->gLogin( SOC_LOGIN_NAME ) ) ) ) );
-    client->sState( SOC_STATE_LOAD_ACCOUNT );
-
-    //Generate the next input prompt
-    LoginHandler( client );
+    // Handler::PasswordVerified() resumes from here once the password has been hashed
+    if ( !VerifyPassword( client, cmd ) )
+        client->Send( CFG_STR_ACT_PASSWORD_GET );
 
     return;
 }
@@ -1591,7 +1672,7 @@ const void Handler::LoadCharacter( SocketClient* client, const string& cmd, cons
         chr->Delete();
 
         client->sState( SOC_STATE_RECONNECTING );
-        chr = FindCharacter( id.str(), HANDLER_FIND_ID, character_list );
+        chr = static_cast<Character*>( Thing::Find( id.str(), character_index ) );
         Reconnect( client, chr );
 
         return;
@@ -0,0 +1,249 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file hasher.cpp
+ * @brief All non-template member functions of the Hasher class.
+ *
+ * Hashing a password with a modern crypt() method is deliberately slow, far
+ * too slow to do on the game thread while every other player waits. The
+ * game thread queues each password as a Hasher::Job and parks the client in
+ * #SOC_STATE_VERIFYING; a fixed number of threads hash the passwords with
+ * crypt_r() and leave the results for the game thread to collect via
+ * Hasher::Pop(), addressed to the client by handle.
+ */
+#include "h/includes.h"
+#include "h/hasher.h"
+
+#include "h/reactor.h"
+
+/* Core */
+/**
+ * @brief Stop every thread in the pool and unload the Hasher from memory. Called from the game thread.
+ * @retval void
+ */
+const void Hasher::Delete()
+{
+    UFLAGS_DE( flags );
+    ITER( vector, pthread_t, ti );
+
+    ::pthread_mutex_lock( &m_mutex );
+    m_running = false;
+    ::pthread_cond_broadcast( &m_wake );
+    ::pthread_mutex_unlock( &m_mutex );
+
+    for ( ti = m_threads.begin(); ti != m_threads.end(); ti++ )
+        if ( ::pthread_join( *ti, NULL ) != 0 )
+            LOGERRNO( flags, "Hasher::Delete()->pthread_join()->" );
+
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Queue a password to be hashed. Called from the game thread.
+ * @param[in] job The password, salt, and the SocketClient it belongs to.
+ * @retval false Returned if the host already has #CFG_SEC_CRYPT_MAX_HOST jobs outstanding or #CFG_SEC_CRYPT_QUEUE jobs are already waiting.
+ * @retval true Returned if the job was queued; the result will later be collected via Hasher::Pop().
+ */
+const bool Hasher::Hash( const Hasher::Job& job )
+{
+    UFLAGS_DE( flags );
+    map<string,uint_t>::iterator hi;
+    bool queued = false;
+
+    if ( job.m_password.empty() )
+    {
+        LOGSTR( flags, "Hasher::Hash()-> called with empty password" );
+        return false;
+    }
+
+    if ( ( hi = m_hosts.find( job.m_host ) ) != m_hosts.end() && hi->second >= CFG_SEC_CRYPT_MAX_HOST )
+    {
+        LOGFMT( flags, "Hasher::Hash()-> host %s already has %lu passwords being verified", CSTR( job.m_host ), hi->second );
+        return false;
+    }
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    if ( m_queue.size() < CFG_SEC_CRYPT_QUEUE )
+    {
+        m_queue.push_back( job );
+        ::pthread_cond_signal( &m_wake );
+        queued = true;
+    }
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    if ( !queued )
+    {
+        LOGFMT( flags, "Hasher::Hash()-> queue is full, refusing password from host %s", CSTR( job.m_host ) );
+        return false;
+    }
+
+    m_hosts[job.m_host]++;
+
+    return true;
+}
+
+/**
+ * @brief Start the threads of the pool.
+ * @retval false Returned if a thread was unable to be started.
+ * @retval true Returned if all #CFG_SEC_CRYPT_THREADS threads were started.
+ */
+const bool Hasher::New()
+{
+    UFLAGS_DE( flags );
+    pthread_t thread;
+    uint_t i = 0;
+
+    m_running = true;
+
+    for ( i = 0; i < CFG_SEC_CRYPT_THREADS; i++ )
+    {
+        if ( ::pthread_create( &thread, NULL, &Hasher::tUpdate, this ) != 0 )
+        {
+            LOGERRNO( flags, "Hasher::New()->pthread_create()->" );
+            return false;
+        }
+
+        m_threads.push_back( thread );
+    }
+
+    return true;
+}
+
+/**
+ * @brief Retrieve the next hashed job. Called from the game thread.
+ * @param[out] job The completed job, with Hasher::Job::m_hash set.
+ * @retval false Returned if there are no completed jobs waiting.
+ * @retval true Returned if job has been set.
+ */
+const bool Hasher::Pop( Hasher::Job& job )
+{
+    map<string,uint_t>::iterator hi;
+    bool found = false;
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    if ( !m_results.empty() )
+    {
+        job = m_results.front();
+        m_results.pop_front();
+        found = true;
+    }
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    if ( found && ( hi = m_hosts.find( job.m_host ) ) != m_hosts.end() && --hi->second == 0 )
+        m_hosts.erase( hi );
+
+    return found;
+}
+
+/**
+ * @brief Wait for a job to be queued, hash it, then leave it for the game thread. Called from the pool.
+ * @param[in] data Working storage for crypt_r(), owned by the calling thread.
+ * @retval false Returned once the pool has been asked to exit.
+ * @retval true Returned if a job was hashed.
+ */
+const bool Hasher::Update( crypt_data& data )
+{
+    UFLAGS_DE( flags );
+    Hasher::Job job;
+    char* hash = NULL;
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    while ( m_running && m_queue.empty() )
+        ::pthread_cond_wait( &m_wake, &m_mutex );
+
+    if ( !m_running )
+    {
+        ::pthread_mutex_unlock( &m_mutex );
+        return false;
+    }
+
+    job = m_queue.front();
+    m_queue.pop_front();
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    if ( ( hash = ::crypt_r( CSTR( job.m_password ), CSTR( job.m_salt ), &data ) ) == NULL )
+        LOGERRNO( flags, "Hasher::Update()->crypt_r()->" );
+    else
+        job.m_hash = hash;
+
+    job.m_password.clear();
+
+    ::pthread_mutex_lock( &m_mutex );
+    m_results.push_back( job );
+    ::pthread_mutex_unlock( &m_mutex );
+
+    g_global->m_reactor->Wake();
+
+    return true;
+}
+
+/* Query */
+
+/* Manipulate */
+/**
+ * @brief The body of each thread in the pool.
+ * @param[in] data A self-reference passed via this to use for callback.
+ * @retval void
+ */
+void* Hasher::tUpdate( void* data )
+{
+    Hasher* hasher = reinterpret_cast<Hasher*>( data );
+    crypt_data* storage = new crypt_data();
+
+    while ( hasher->Update( *storage ) );
+
+    delete storage;
+
+    ::pthread_exit( reinterpret_cast<void*>( EXIT_SUCCESS ) );
+}
+
+/* Internal */
+/**
+ * @brief Constructor for the Hasher class.
+ */
+Hasher::Hasher()
+{
+    m_hosts.clear();
+    ::pthread_mutex_init( &m_mutex, NULL );
+    m_queue.clear();
+    m_results.clear();
+    m_running = false;
+    m_threads.clear();
+    ::pthread_cond_init( &m_wake, NULL );
+
+    return;
+}
+
+/**
+ * @brief Destructor for the Hasher class.
+ */
+Hasher::~Hasher()
+{
+    ::pthread_cond_destroy( &m_wake );
+    ::pthread_mutex_destroy( &m_mutex );
+
+    return;
+}
@@ -0,0 +1,401 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file iothread.cpp
+ * @brief All non-template member functions of the IOThread class.
+ *
+ * Each IOThread runs its own Reactor over the SocketClient objects assigned to
+ * it. The game thread never touches those sockets directly; instead the two
+ * sides trade requests and notices through a pair of SPSCQueue objects and
+ * wake one another via Reactor::Wake(). A SocketClient is only released by the
+ * game thread once its I/O thread has reported #SOC_IO_CLOSED, so no locking is
+ * required around the lifetime of a client.
+ */
+#include "h/includes.h"
+#include "h/iothread.h"
+
+#include "h/reactor.h"
+#include "h/socketclient.h"
+
+/* Core */
+/**
+ * @brief Stop the thread, release any clients it has finished with, and unload it from memory. Called from the game thread.
+ * @retval void
+ */
+const void IOThread::Delete()
+{
+    UFLAGS_DE( flags );
+    pair<SocketClient*,uint_t> notice;
+
+    if ( m_running )
+    {
+        // Requests are handled in order, so any output or closes posted before this are completed first
+        Post( NULL, SOC_IO_STOP );
+        Wake();
+
+        if ( ::pthread_join( m_thread, NULL ) != 0 )
+            LOGERRNO( flags, "IOThread::Delete()->pthread_join()->" );
+
+        m_running = false;
+    }
+
+    while ( Pop( notice ) );
+
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Stop watching a client whose connection has failed and inform the game thread. Called from the I/O thread.
+ * @param[in] socket_client The SocketClient which failed.
+ * @retval void
+ */
+const void IOThread::Hangup( SocketClient* socket_client )
+{
+    UFLAGS_DE( flags );
+
+    if ( socket_client->gHangup() )
+        return;
+
+    if ( !m_reactor->Remove( socket_client ) )
+        LOGFMT( flags, "IOThread::Hangup()->Reactor::Remove()-> descriptor %ld returned false", socket_client->gDescriptor() );
+
+    if ( find( m_limited.begin(), m_limited.end(), socket_client ) != m_limited.end() )
+        m_limited.erase( find( m_limited.begin(), m_limited.end(), socket_client ) );
+
+    socket_client->sHangup( true );
+    Notify( socket_client, SOC_IO_HANGUP );
+
+    return;
+}
+
+/**
+ * @brief Create the reactor and start the thread.
+ * @retval false Returned if the reactor or thread were unable to be created.
+ * @retval true Returned if the thread was successfully started.
+ */
+const bool IOThread::New()
+{
+    UFLAGS_DE( flags );
+
+    m_reactor = new Reactor();
+
+    if ( !m_reactor->New() )
+    {
+        LOGSTR( flags, "IOThread::New()->Reactor::New()-> returned false" );
+        return false;
+    }
+
+    if ( ::pthread_create( &m_thread, NULL, &IOThread::tUpdate, this ) != 0 )
+    {
+        LOGERRNO( flags, "IOThread::New()->pthread_create()->" );
+        return false;
+    }
+
+    m_running = true;
+
+    return true;
+}
+
+/**
+ * @brief Queue a notice for the game thread. Called from the I/O thread.
+ * @param[in] socket_client The SocketClient the notice concerns.
+ * @param[in] type A notice type from #SOC_IO.
+ * @retval void
+ */
+const void IOThread::Notify( SocketClient* socket_client, const uint_t& type )
+{
+    m_notices.Push( pair<SocketClient*,uint_t>( socket_client, type ) );
+    m_notified = true;
+
+    return;
+}
+
+/**
+ * @brief Retrieve the next notice for a live client. Clients which the I/O thread has finished closing are released here. Called from the game thread.
+ * @param[out] notice The SocketClient and #SOC_IO type of the notice.
+ * @retval false Returned if there are no further notices.
+ * @retval true Returned if notice was populated.
+ */
+const bool IOThread::Pop( pair<SocketClient*,uint_t>& notice )
+{
+    while ( m_notices.Pop( notice ) )
+    {
+        // Always the final notice for a client; nothing else can still reference it
+        if ( notice.second == SOC_IO_CLOSED )
+        {
+            delete notice.first;
+            continue;
+        }
+
+        // Raced with the game deleting the client; it is already waiting on SOC_IO_CLOSED
+        if ( notice.first->Closing() )
+            continue;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Queue a request for the I/O thread. The thread isn't woken until IOThread::Wake() is called. Called from the game thread.
+ * @param[in] socket_client The SocketClient the request concerns.
+ * @param[in] type A request type from #SOC_IO.
+ * @retval void
+ */
+const void IOThread::Post( SocketClient* socket_client, const uint_t& type )
+{
+    m_posts.Push( pair<SocketClient*,uint_t>( socket_client, type ) );
+    m_posted = true;
+
+    return;
+}
+
+/**
+ * @brief Read input from a client and inform the game thread. Throttled clients are left unread, and clients which exceed
+ * #CFG_SOC_INPUT_BYTE_RATE are read again once every #CFG_SOC_INPUT_RETRY milliseconds. Called from the I/O thread.
+ * @param[in] socket_client The SocketClient to read from.
+ * @retval void
+ */
+const void IOThread::Read( SocketClient* socket_client )
+{
+    // Left in the kernel until the client catches up on its output; IOThread::Write() resumes reading
+    if ( socket_client->gThrottled() )
+        return;
+
+    // A hangup or reset will surface as a failed read
+    if ( !socket_client->Recv() )
+    {
+        Hangup( socket_client );
+        return;
+    }
+
+    if ( socket_client->gInputLimited() && find( m_limited.begin(), m_limited.end(), socket_client ) == m_limited.end() )
+    {
+        if ( m_limited.empty() )
+            m_retry = chrono::steady_clock::now() + chrono::milliseconds( CFG_SOC_INPUT_RETRY );
+
+        m_limited.push_back( socket_client );
+
+        if ( !g_stats->aInputLimited( 1 ) )
+            LOGFMT( 0, "IOThread::Read()->Server::Stats::aInputLimited()-> value %lu returned false", g_stats->gInputLimited() + 1 );
+    }
+
+    Notify( socket_client, SOC_IO_INPUT );
+
+    return;
+}
+
+/**
+ * @brief Wait for socket activity or requests from the game thread and handle them. Called from the I/O thread.
+ * @retval false Returned if the thread has been asked to stop or the reactor has failed.
+ * @retval true Returned if the thread should continue running.
+ */
+const bool IOThread::Update()
+{
+    UFLAGS_DE( flags );
+    pair<SocketClient*,uint_t> post;
+    SocketClient* socket_client = NULL;
+    Socket* socket = NULL;
+    vector<SocketClient*> limited;
+    ITER( vector, SocketClient*, li );
+    sint_t ready = 0, timeout = -1;
+    uint_t events = 0, i = 0;
+    bool running = true;
+
+    // Clients with unread input won't be reported by the reactor again, so wake up to retry them
+    if ( !m_limited.empty() )
+        timeout = max<sint_t>( 0, chrono::duration_cast<chrono::milliseconds>( m_retry - chrono::steady_clock::now() ).count() );
+
+    if ( ( ready = m_reactor->Wait( timeout ) ) < 0 )
+    {
+        LOGSTR( flags, "IOThread::Update()->Reactor::Wait()-> returned an error" );
+        return false;
+    }
+
+    // Anything still over its rate is added back by IOThread::Read()
+    if ( !m_limited.empty() && chrono::steady_clock::now() >= m_retry )
+    {
+        limited.swap( m_limited );
+        for ( li = limited.begin(); li != limited.end(); li++ )
+            Read( *li );
+    }
+
+    for ( i = 0; i < static_cast<uint_t>( ready ); i++ )
+    {
+        // Wake-ups from the game thread, or removed by an earlier event within this same batch
+        if ( ( socket = m_reactor->gSocket( i ) ) == NULL )
+            continue;
+
+        events = m_reactor->gEvents( i );
+        socket_client = static_cast<SocketClient*>( socket );
+
+        if ( events & ( EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR ) )
+            Read( socket_client );
+
+        // The socket can accept data again; resume any output that was held back when it last filled up
+        if ( events & EPOLLOUT && !socket_client->gHangup() )
+        {
+            socket_client->sWritable( true );
+            Write( socket_client );
+        }
+    }
+
+    while ( m_posts.Pop( post ) )
+    {
+        socket_client = post.first;
+
+        switch ( post.second )
+        {
+            case SOC_IO_ADD:
+                // Registered once for the lifetime of the client; edge-triggered so that only state changes are reported
+                if ( !m_reactor->Add( socket_client, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET ) )
+                {
+                    LOGFMT( flags, "IOThread::Update()->Reactor::Add()-> descriptor %ld returned false", socket_client->gDescriptor() );
+                    socket_client->sHangup( true );
+                    Notify( socket_client, SOC_IO_HANGUP );
+                }
+            break;
+
+            case SOC_IO_CLOSE:
+                if ( find( m_limited.begin(), m_limited.end(), socket_client ) != m_limited.end() )
+                    m_limited.erase( find( m_limited.begin(), m_limited.end(), socket_client ) );
+
+                // Last chance to get output out; anything that doesn't fit in the socket is discarded
+                if ( !socket_client->gHangup() )
+                {
+                    socket_client->Flush();
+
+                    if ( !m_reactor->Remove( socket_client ) )
+                        LOGFMT( flags, "IOThread::Update()->Reactor::Remove()-> descriptor %ld returned false", socket_client->gDescriptor() );
+
+                    socket_client->sHangup( true );
+                }
+
+                Notify( socket_client, SOC_IO_CLOSED );
+            break;
+
+            case SOC_IO_FLUSH:
+                if ( !socket_client->gHangup() )
+                    Write( socket_client );
+            break;
+
+            case SOC_IO_STOP:
+                running = false;
+            break;
+
+            default:
+                LOGFMT( flags, "IOThread::Update()-> called with invalid request type: %lu", post.second );
+            break;
+        }
+    }
+
+    if ( m_notified )
+    {
+        m_notified = false;
+        g_global->m_reactor->Wake();
+    }
+
+    return running;
+}
+
+/**
+ * @brief Wake the I/O thread if any requests have been posted since it was last woken. Called from the game thread.
+ * @retval void
+ */
+const void IOThread::Wake()
+{
+    UFLAGS_DE( flags );
+
+    if ( !m_posted )
+        return;
+
+    m_posted = false;
+
+    if ( !m_reactor->Wake() )
+        LOGSTR( flags, "IOThread::Wake()->Reactor::Wake()-> returned false" );
+
+    return;
+}
+
+/**
+ * @brief Write queued output to a client, resuming reads if it was throttled and has now caught up. Called from the I/O thread.
+ * @param[in] socket_client The SocketClient to write to.
+ * @retval void
+ */
+const void IOThread::Write( SocketClient* socket_client )
+{
+    bool throttled = socket_client->gThrottled();
+
+    if ( !socket_client->Flush() )
+    {
+        Hangup( socket_client );
+        return;
+    }
+
+    // Edge-triggered readiness won't be reported again for input that arrived while throttled, so read it now
+    if ( throttled && !socket_client->gThrottled() )
+        Read( socket_client );
+
+    return;
+}
+
+/* Query */
+
+/* Manipulate */
+/**
+ * @brief The body of the I/O thread.
+ * @param[in] data A self-reference passed via this to use for callback.
+ * @retval void
+ */
+void* IOThread::tUpdate( void* data )
+{
+    IOThread* io_thread = reinterpret_cast<IOThread*>( data );
+
+    while ( io_thread->Update() );
+
+    ::pthread_exit( reinterpret_cast<void*>( EXIT_SUCCESS ) );
+}
+
+/* Internal */
+/**
+ * @brief Constructor for the IOThread class.
+ */
+IOThread::IOThread()
+{
+    m_notified = false;
+    m_posted = false;
+    m_reactor = NULL;
+    m_retry = chrono::steady_clock::now();
+    m_running = false;
+
+    return;
+}
+
+/**
+ * @brief Destructor for the IOThread class.
+ */
+IOThread::~IOThread()
+{
+    if ( m_reactor != NULL )
+        m_reactor->Delete();
+
+    return;
+}
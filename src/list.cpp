@@ -40,12 +40,35 @@ vector<AIProg*> aiprog_list;
  */
 vector<Brain*> brain_list;
 
+/**
+ * @var character_delete_list
+ * @brief Characters removed by Character::Delete() during the current pulse. They are freed by Server::FreeDeleted() once nothing can still hold a pointer to them.
+ * @param Character* A pointer to a Character object in memory.
+ */
+vector<Character*> character_delete_list;
+
+/**
+ * @var character_index
+ * @brief Every Character within #character_list, keyed by id for Handler::FindCharacter().
+ * @param string The id of the Thing.
+ * @param Thing* A pointer to the Thing in memory.
+ */
+ThingIndex character_index;
+
 /**
  * @var character_list
- * @brief All characters that exist within the server.
+ * @brief All characters that exist within the server. Walked by position; removals are compacted at the end of each pulse.
  * @param Character* A pointer to a Character object in memory.
  */
-vector<Character*> character_list;
+SlotMap<Character*> character_list;
+
+/**
+ * @var character_template_index
+ * @brief Every Character within #character_template_list, keyed by id for Handler::FindCharacter().
+ * @param string The id of the Thing.
+ * @param Thing* A pointer to the Thing in memory.
+ */
+ThingIndex character_template_index;
 
 /**
  * @var character_template_list
@@ -55,18 +78,19 @@ vector<Character*> character_list;
 vector<Character*> character_template_list;
 
 /**
- * @var command_list
- * @brief All commands loaded into memory.
+ * @var command_index
+ * @brief All commands loaded into memory, ordered by name for Handler::FindCommand(). Names are folded to lowercase if #CFG_GAM_CMD_IGNORE_CASE is set.
+ * @param string The name of the Command.
  * @param Command* A pointer to a Command object in memory.
  */
-vector<Command*> command_list;
+vector< pair<string,Command*> > command_index;
 
 /**
- * @var event_list
- * @brief All events pending execution.
- * @param Event* A pointer to an Event object in memory.
+ * @var command_list
+ * @brief All commands loaded into memory.
+ * @param Command* A pointer to a Command object in memory.
  */
-vector<Event*> event_list;
+vector<Command*> command_list;
 
 /**
  * @var exit_list
@@ -75,6 +99,14 @@ vector<Event*> event_list;
  */
 vector<Exit*> exit_list;
 
+/**
+ * @var location_index
+ * @brief Every Location within #location_list, keyed by id for Handler::FindLocation().
+ * @param string The id of the Thing.
+ * @param Thing* A pointer to the Thing in memory.
+ */
+ThingIndex location_index;
+
 /**
  * @var location_list
  * @brief All locations that exist within the server.
@@ -82,12 +114,35 @@ vector<Exit*> exit_list;
  */
 vector<Location*> location_list;
 
+/**
+ * @var object_delete_list
+ * @brief Objects removed by Object::Delete() during the current pulse. They are freed by Server::FreeDeleted() once nothing can still hold a pointer to them.
+ * @param Object* A pointer to an Object object in memory.
+ */
+vector<Object*> object_delete_list;
+
+/**
+ * @var object_index
+ * @brief Every Object within #object_list, keyed by id for Handler::FindObject().
+ * @param string The id of the Thing.
+ * @param Thing* A pointer to the Thing in memory.
+ */
+ThingIndex object_index;
+
 /**
  * @var object_list
- * @brief All objects that exist as a copy of a template within the server.
+ * @brief All objects that exist as a copy of a template within the server. Walked by position; removals are compacted at the end of each pulse.
  * @param Object* A pointer to an Object copy in memory.
  */
-vector<Object*> object_list;
+SlotMap<Object*> object_list;
+
+/**
+ * @var object_template_index
+ * @brief Every Object within #object_template_list, keyed by id for Handler::FindObject().
+ * @param string The id of the Thing.
+ * @param Thing* A pointer to the Thing in memory.
+ */
+ThingIndex object_template_index;
 
 /**
  * @var object_template_list
@@ -98,7 +153,15 @@ vector<Object*> object_template_list;
 
 /**
  * @var socket_client_list
- * @brief All SocketClient objects connected to the server.
+ * @brief All SocketClient objects connected to the server. Walked by position; removals are compacted at the end of each pulse.
  * @param SocketClient* A pointer to a SocketClient object in memory.
  */
-vector<SocketClient*> socket_client_list;
+SlotMap<SocketClient*> socket_client_list;
+
+/**
+ * @var socket_client_output_list
+ * @brief All SocketClient objects with output queued since the last pulse, or which are quitting. A client deleted meanwhile is
+ * simply left behind, as its handle no longer resolves within socket_client_list.
+ * @param SlotHandle The handle of a SocketClient object within socket_client_list.
+ */
+vector<SlotHandle> socket_client_output_list;
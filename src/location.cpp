@@ -92,6 +92,7 @@ const bool Location::New( const string& file )
     }
 
     location_list.push_back( this );
+    Index( &location_index );
 
     return true;
 }
@@ -246,10 +247,11 @@ const bool Location::Unserialize()
 
 /* Query */
 /**
- * @brief Returns the list of Exits associated to this Location.
- * @retval vector<Exit*> A list of pointers to Exit objects associated with this Location.
+ * @brief Returns the list of Exits associated to this Location without copying it.
+ * @retval vector<Exit*> A read-only view of the Exit objects associated with this Location. It reflects any later change to the
+ * exits; use Utils::Advance() to walk it if an Exit may be removed during the walk.
  */
-vector<Exit*> Location::gExits() const
+const vector<Exit*>& Location::gExits() const
 {
     return m_exits;
 }
@@ -270,7 +272,8 @@ const void Location::RemoveExit( Exit* exit )
         return;
     }
 
-    m_exits.erase( find( m_exits.begin(), m_exits.end(), exit ) );
+    if ( find( m_exits.begin(), m_exits.end(), exit ) != m_exits.end() )
+        m_exits.erase( find( m_exits.begin(), m_exits.end(), exit ) );
 
     return;
 }
@@ -25,6 +25,7 @@
 #include "h/object.h"
 
 #include "h/list.h"
+#include "h/pool.h"
 
 /* Core */
 /**
@@ -59,14 +60,15 @@ const bool Object::Clone( const string& name, const uint_t& type )
     /** Copy elements from Thing parent class */
     for ( search = 0; search < MAX_THING_DESCRIPTION; search++ )
         sDescription( obj->gDescription( search ), search );
-    sName( obj->gName() );
-    sZone( obj->gZone() );
+    sName( obj->gNameAtom() );
+    sZone( obj->gZoneAtom() );
     /** Copy elements internal to Object class */
     m_file = obj->m_file;
-    /** Generate a unique id based on obj_list.size() and current time */
-    NewId( object_list.size() );
+    /** Generate a unique id */
+    NewId();
 
-    object_list.push_back( this );
+    m_list_handle = object_list.Add( this );
+    Index( &object_index );
 
     return true;
 }
@@ -77,12 +79,17 @@ const bool Object::Clone( const string& name, const uint_t& type )
  */
 const void Object::Delete()
 {
-    if ( find( object_list.begin(), object_list.end(), this ) != object_list.end() )
-        g_global->m_next_object = object_list.erase( find( object_list.begin(), object_list.end(), this ) );
+    if ( m_list_handle != 0 )
+        object_list.Remove( m_list_handle );
     else if ( find( object_template_list.begin(), object_template_list.end(), this ) != object_template_list.end() )
             object_template_list.erase( find( object_template_list.begin(), object_template_list.end(), this ) );
 
-    delete this;
+    Unindex();
+    if ( !g_global->m_shutdown && gContainer() != NULL )
+        gContainer()->RemoveThing( this );
+
+    // A loop further up the stack may still hold this pointer, so the memory is only released by Server::FreeDeleted()
+    object_delete_list.push_back( this );
 
     return;
 }
@@ -126,6 +133,7 @@ const bool Object::New( const string& file )
     }
 
     object_template_list.push_back( this );
+    Index( &object_template_index );
 
     return true;
 }
@@ -259,6 +267,7 @@ Object::Object()
     sType( THING_TYPE_OBJECT );
     /** Initialize attributes specific to Objects */
     m_file.clear();
+    m_list_handle = 0;
 
     return;
 }
@@ -270,3 +279,26 @@ Object::~Object()
 {
     return;
 }
+
+/**
+ * @brief Allocate memory for an Object from its Pool.
+ * @param[in] size The size of the object being created.
+ * @retval void* A pointer to the memory.
+ */
+void* Object::operator new( size_t size )
+{
+    return g_global->m_object_pool->Allocate( size );
+}
+
+/**
+ * @brief Return the memory of an Object to its Pool.
+ * @param[in] ptr A pointer to the memory of the deleted object.
+ * @param[in] size The size of the deleted object.
+ * @retval void
+ */
+void Object::operator delete( void* ptr, size_t size )
+{
+    g_global->m_object_pool->Free( ptr, size );
+
+    return;
+}
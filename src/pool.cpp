@@ -0,0 +1,240 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file pool.cpp
+ * @brief All non-template member functions of the Pool class.
+ *
+ * A class served by a Pool overrides operator new and operator delete to
+ * call Pool::Allocate() and Pool::Free(). Chunks are taken from and returned
+ * to a free list threaded through the unused chunks themselves. Blocks are
+ * only returned to the system when the pool is deleted at shutdown.
+ * Requests of any other size, such as from a derived class, are passed
+ * through to the global operators.
+ */
+#include "h/includes.h"
+#include "h/pool.h"
+
+/* Core */
+/**
+ * @brief Hand out a chunk of memory.
+ * @param[in] size The size requested of operator new.
+ * @retval void* A pointer to the memory. Failure is reported by throwing std::bad_alloc, as with the global operator new.
+ */
+void* Pool::Allocate( const size_t& size )
+{
+    UFLAGS_DE( flags );
+    void* ptr = NULL;
+
+    if ( size > m_size )
+        return ::operator new( size );
+
+    if ( m_free == NULL && !Grow() )
+    {
+        LOGFMT( flags, "Pool::Allocate()->Pool::Grow()-> %s pool returned false", CSTR( m_name ) );
+        throw bad_alloc();
+    }
+
+    ptr = m_free;
+    m_free = *reinterpret_cast<void**>( ptr );
+    m_free_count--;
+    m_in_use++;
+    m_allocations++;
+
+    return ptr;
+}
+
+/**
+ * @brief Release every block back to the system and unload the pool from memory.
+ * @retval void
+ */
+const void Pool::Delete()
+{
+    UFLAGS_DE( flags );
+
+    if ( m_in_use > 0 )
+        LOGFMT( flags, "Pool::Delete()-> %s pool still has %lu chunks in use", CSTR( m_name ), m_in_use );
+
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Return a chunk of memory to the pool.
+ * @param[in] ptr A pointer previously returned by Pool::Allocate().
+ * @param[in] size The size passed to operator delete.
+ * @retval void
+ */
+const void Pool::Free( void* ptr, const size_t& size )
+{
+    if ( ptr == NULL )
+        return;
+
+    if ( size > m_size )
+    {
+        ::operator delete( ptr );
+        return;
+    }
+
+    *reinterpret_cast<void**>( ptr ) = m_free;
+    m_free = ptr;
+    m_free_count++;
+    m_in_use--;
+
+    return;
+}
+
+/**
+ * @brief Prepare a pool to serve chunks of a given size.
+ * @param[in] name The name of the class served by the pool.
+ * @param[in] size The size of the class served by the pool.
+ * @retval false Returned if name is empty or size is zero.
+ * @retval true Returned if the pool is ready to hand out memory.
+ */
+const bool Pool::New( const string& name, const size_t& size )
+{
+    UFLAGS_DE( flags );
+
+    if ( name.empty() )
+    {
+        LOGSTR( flags, "Pool::New()-> called with empty name" );
+        return false;
+    }
+
+    if ( size == 0 )
+    {
+        LOGSTR( flags, "Pool::New()-> called with zero size" );
+        return false;
+    }
+
+    m_name = name;
+    // Each unused chunk must be able to hold the free list link, and every chunk must stay suitably aligned for any type
+    m_size = max( size, sizeof( void* ) );
+    m_size = ( ( m_size + alignof( max_align_t ) - 1 ) / alignof( max_align_t ) ) * alignof( max_align_t );
+
+    return true;
+}
+
+/* Query */
+/**
+ * @brief Returns the total number of chunks handed out since boot.
+ * @retval uint_t The number of allocations served by the pool.
+ */
+const uint_t Pool::gAllocations() const
+{
+    return m_allocations;
+}
+
+/**
+ * @brief Returns the number of blocks allocated by the pool.
+ * @retval uint_t The number of blocks.
+ */
+const uint_t Pool::gBlocks() const
+{
+    return m_blocks.size();
+}
+
+/**
+ * @brief Returns the number of chunks waiting to be handed out.
+ * @retval uint_t The number of unused chunks.
+ */
+const uint_t Pool::gFree() const
+{
+    return m_free_count;
+}
+
+/**
+ * @brief Returns the number of chunks currently handed out.
+ * @retval uint_t The number of chunks in use.
+ */
+const uint_t Pool::gInUse() const
+{
+    return m_in_use;
+}
+
+/**
+ * @brief Returns the name of the class served by the pool.
+ * @retval string The name of the class.
+ */
+const string Pool::gName() const
+{
+    return m_name;
+}
+
+/* Manipulate */
+
+/* Internal */
+/**
+ * @brief Constructor for the Pool class.
+ */
+Pool::Pool()
+{
+    m_allocations = 0;
+    m_blocks.clear();
+    m_free = NULL;
+    m_free_count = 0;
+    m_in_use = 0;
+    m_name.clear();
+    m_size = 0;
+
+    return;
+}
+
+/**
+ * @brief Destructor for the Pool class.
+ */
+Pool::~Pool()
+{
+    while ( !m_blocks.empty() )
+    {
+        ::operator delete( m_blocks.back() );
+        m_blocks.pop_back();
+    }
+
+    return;
+}
+
+/**
+ * @brief Allocate another block and add its chunks to the free list.
+ * @retval false Returned if the pool has not been prepared by Pool::New() or the system is out of memory.
+ * @retval true Returned if the free list was refilled.
+ */
+const bool Pool::Grow()
+{
+    char* block = NULL;
+    uint_t i = 0;
+
+    if ( m_size == 0 )
+        return false;
+
+    if ( ( block = static_cast<char*>( ::operator new( m_size * CFG_MEM_POOL_BLOCK, nothrow ) ) ) == NULL )
+        return false;
+
+    m_blocks.push_back( block );
+
+    // Thread the new chunks onto the free list back to front so they are handed out in address order
+    for ( i = CFG_MEM_POOL_BLOCK; i > 0; i-- )
+    {
+        *reinterpret_cast<void**>( block + ( i - 1 ) * m_size ) = m_free;
+        m_free = block + ( i - 1 ) * m_size;
+    }
+
+    m_free_count += CFG_MEM_POOL_BLOCK;
+
+    return true;
+}
@@ -0,0 +1,417 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file reactor.cpp
+ * @brief All non-template member functions of the Reactor class.
+ *
+ * A Reactor wraps an epoll instance. Each Socket is registered once and stays
+ * registered until it is removed, so Reactor::Wait() only hands back the
+ * sockets which actually have pending activity rather than every connection.
+ * An optional periodic timer shares the same epoll instance so that a single
+ * call to Reactor::Wait() blocks until either a socket is ready or the next
+ * deadline passes. Other threads may interrupt a blocked Reactor::Wait() at any
+ * time via Reactor::Wake().
+ */
+#include "h/includes.h"
+#include "h/reactor.h"
+
+#include "h/socket.h"
+
+/* Core */
+/**
+ * @brief Register a Socket to be watched for activity.
+ * @param[in] socket The Socket to be watched.
+ * @param[in] events A mask of epoll events to watch for, such as EPOLLIN | EPOLLOUT | EPOLLET.
+ * @retval false Returned if the Socket is invalid or unable to be registered.
+ * @retval true Returned if the Socket was successfully registered.
+ */
+const bool Reactor::Add( Socket* socket, const uint_t& events )
+{
+    UFLAGS_DE( flags );
+    static epoll_event ev_zero;
+    epoll_event event = ev_zero;
+
+    if ( socket == NULL )
+    {
+        LOGSTR( flags, "Reactor::Add()-> called with NULL socket" );
+        return false;
+    }
+
+    if ( !socket->Valid() )
+    {
+        LOGSTR( flags, "Reactor::Add()-> called with invalid socket" );
+        return false;
+    }
+
+    event.events = events;
+    event.data.ptr = socket;
+
+    if ( ::epoll_ctl( m_descriptor, EPOLL_CTL_ADD, socket->gDescriptor(), &event ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::Add()->epoll_ctl()->" );
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Unload a reactor from memory that was previously loaded via Reactor::New().
+ * @retval void
+ */
+const void Reactor::Delete()
+{
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Change the events being watched for on a previously registered Socket.
+ * @param[in] socket The Socket to be modified.
+ * @param[in] events A mask of epoll events to watch for, such as EPOLLIN | EPOLLOUT | EPOLLET.
+ * @retval false Returned if the Socket is invalid or unable to be modified.
+ * @retval true Returned if the Socket was successfully modified.
+ */
+const bool Reactor::Modify( Socket* socket, const uint_t& events )
+{
+    UFLAGS_DE( flags );
+    static epoll_event ev_zero;
+    epoll_event event = ev_zero;
+
+    if ( socket == NULL )
+    {
+        LOGSTR( flags, "Reactor::Modify()-> called with NULL socket" );
+        return false;
+    }
+
+    if ( !socket->Valid() )
+    {
+        LOGSTR( flags, "Reactor::Modify()-> called with invalid socket" );
+        return false;
+    }
+
+    event.events = events;
+    event.data.ptr = socket;
+
+    if ( ::epoll_ctl( m_descriptor, EPOLL_CTL_MOD, socket->gDescriptor(), &event ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::Modify()->epoll_ctl()->" );
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Create a new epoll instance.
+ * @retval false Returned if the epoll instance was unable to be created.
+ * @retval true Returned if the epoll instance was successfully created.
+ */
+const bool Reactor::New()
+{
+    UFLAGS_DE( flags );
+    static epoll_event ev_zero;
+    epoll_event event = ev_zero;
+
+    if ( ( m_descriptor = ::epoll_create1( EPOLL_CLOEXEC ) ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::New()->epoll_create1()->" );
+        return false;
+    }
+
+    if ( ( m_wake = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC ) ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::New()->eventfd()->" );
+        return false;
+    }
+
+    event.events = EPOLLIN;
+    event.data.ptr = &m_wake;
+
+    if ( ::epoll_ctl( m_descriptor, EPOLL_CTL_ADD, m_wake, &event ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::New()->epoll_ctl()->" );
+        return false;
+    }
+
+    m_events.resize( CFG_SOC_MAX_EVENTS );
+
+    return true;
+}
+
+/**
+ * @brief Stop watching a Socket for activity.
+ * @param[in] socket The Socket to stop watching.
+ * @retval false Returned if the Socket is invalid or unable to be removed.
+ * @retval true Returned if the Socket was successfully removed.
+ */
+const bool Reactor::Remove( Socket* socket )
+{
+    UFLAGS_DE( flags );
+    static epoll_event ev_zero;
+    epoll_event event = ev_zero;
+    uint_t i = uintmin_t;
+
+    if ( socket == NULL )
+    {
+        LOGSTR( flags, "Reactor::Remove()-> called with NULL socket" );
+        return false;
+    }
+
+    if ( !socket->Valid() )
+    {
+        LOGSTR( flags, "Reactor::Remove()-> called with invalid socket" );
+        return false;
+    }
+
+    // Events from the current batch may still reference this socket, so ensure they are never handed out
+    for ( i = 0; i < m_ready; i++ )
+        if ( m_events[i].data.ptr == socket )
+            m_events[i].data.ptr = NULL;
+
+    if ( ::epoll_ctl( m_descriptor, EPOLL_CTL_DEL, socket->gDescriptor(), &event ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::Remove()->epoll_ctl()->" );
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wait for activity on any registered Socket or for the timer set via Reactor::sTimer() to expire.
+ * @param[in] timeout Maximum time to wait in milliseconds. 0 returns immediately and -1 blocks indefinitely.
+ * @retval sint_t The number of events with pending activity, or -1 on error. Timer and wake events are reported as a NULL Socket.
+ */
+const sint_t Reactor::Wait( const sint_t& timeout )
+{
+    UFLAGS_DE( flags );
+    sint_t ready = 0;
+    uint64_t expired = 0, signal = 0;
+    uint_t i = uintmin_t;
+
+    m_expired = 0;
+    m_ready = 0;
+
+    if ( ( ready = ::epoll_wait( m_descriptor, &m_events[0], m_events.size(), timeout ) ) < 0 )
+    {
+        // Interrupted by a signal; nothing is ready but this isn't fatal
+        if ( errno == EINTR )
+            return 0;
+
+        LOGERRNO( flags, "Reactor::Wait()->epoll_wait()->" );
+        return -1;
+    }
+
+    m_ready = ready;
+
+    for ( i = 0; i < m_ready; i++ )
+    {
+        // Only the wake-up itself matters, not how many times it was requested
+        if ( m_events[i].data.ptr == &m_wake )
+        {
+            if ( ::read( m_wake, &signal, sizeof( signal ) ) < 0 && errno != EAGAIN )
+                LOGERRNO( flags, "Reactor::Wait()->read()->" );
+
+            m_events[i].data.ptr = NULL;
+            continue;
+        }
+
+        if ( m_events[i].data.ptr != &m_timer )
+            continue;
+
+        // The read returns how many deadlines have passed since it was last read, which may be more than one if we fell behind
+        if ( ::read( m_timer, &expired, sizeof( expired ) ) == sizeof( expired ) )
+            m_expired += expired;
+        else if ( errno != EAGAIN )
+            LOGERRNO( flags, "Reactor::Wait()->read()->" );
+
+        m_events[i].data.ptr = NULL;
+    }
+
+    return ready;
+}
+
+/**
+ * @brief Interrupt a call to Reactor::Wait() which is blocked, or cause the next call to return immediately. Safe to call from any thread.
+ * @retval false Returned if the reactor was unable to be signaled.
+ * @retval true Returned if the reactor was successfully signaled.
+ */
+const bool Reactor::Wake()
+{
+    UFLAGS_DE( flags );
+    uint64_t signal = 1;
+
+    if ( ::write( m_wake, &signal, sizeof( signal ) ) < 0 && errno != EAGAIN )
+    {
+        LOGERRNO( flags, "Reactor::Wake()->write()->" );
+        return false;
+    }
+
+    return true;
+}
+
+/* Query */
+/**
+ * @brief Returns the events that were reported for a Socket by the most recent call to Reactor::Wait().
+ * @param[in] pos The position within the results of Reactor::Wait().
+ * @retval uint_t A mask of epoll events, such as EPOLLIN | EPOLLOUT.
+ */
+const uint_t Reactor::gEvents( const uint_t& pos ) const
+{
+    UFLAGS_DE( flags );
+
+    if ( pos >= m_ready )
+    {
+        LOGFMT( flags, "Reactor::gEvents()-> called with invalid pos: %lu", pos );
+        return 0;
+    }
+
+    return m_events[pos].events;
+}
+
+/**
+ * @brief Returns the number of timer deadlines that passed during the most recent call to Reactor::Wait().
+ * @retval uint_t The number of deadlines that passed. Anything beyond 1 means the caller fell behind schedule.
+ */
+const uint_t Reactor::gExpired() const
+{
+    return m_expired;
+}
+
+/**
+ * @brief Returns a Socket that was reported by the most recent call to Reactor::Wait().
+ * @param[in] pos The position within the results of Reactor::Wait().
+ * @retval Socket* A pointer to the Socket with pending activity, or NULL if it has since been removed.
+ */
+Socket* Reactor::gSocket( const uint_t& pos ) const
+{
+    UFLAGS_DE( flags );
+
+    if ( pos >= m_ready )
+    {
+        LOGFMT( flags, "Reactor::gSocket()-> called with invalid pos: %lu", pos );
+        return NULL;
+    }
+
+    return reinterpret_cast<Socket*>( m_events[pos].data.ptr );
+}
+
+/* Manipulate */
+/**
+ * @brief Arm a periodic timer which fires rate times per second, starting one period from now.
+ * @param[in] rate The number of times per second the timer should fire.
+ * @retval false Returned if rate is invalid or the timer was unable to be created or armed.
+ * @retval true Returned if the timer was successfully armed.
+ */
+const bool Reactor::sTimer( const uint_t& rate )
+{
+    UFLAGS_DE( flags );
+    static epoll_event ev_zero;
+    epoll_event event = ev_zero;
+    static itimerspec it_zero;
+    itimerspec spec = it_zero;
+    uint_t period = 0;
+
+    if ( rate < 1 || rate > USLEEP_MAX )
+    {
+        LOGFMT( flags, "Reactor::sTimer()-> called with invalid rate: %lu", rate );
+        return false;
+    }
+
+    if ( m_timer < 0 )
+    {
+        if ( ( m_timer = ::timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC ) ) < 0 )
+        {
+            LOGERRNO( flags, "Reactor::sTimer()->timerfd_create()->" );
+            return false;
+        }
+
+        event.events = EPOLLIN;
+        event.data.ptr = &m_timer;
+
+        if ( ::epoll_ctl( m_descriptor, EPOLL_CTL_ADD, m_timer, &event ) < 0 )
+        {
+            LOGERRNO( flags, "Reactor::sTimer()->epoll_ctl()->" );
+            return false;
+        }
+    }
+
+    if ( ::clock_gettime( CLOCK_MONOTONIC, &spec.it_value ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::sTimer()->clock_gettime()->" );
+        return false;
+    }
+
+    // Deadlines are absolute, so time spent handling one never pushes back the next
+    period = USLEEP_MAX / rate;
+    spec.it_interval.tv_sec = period / USLEEP_MAX;
+    spec.it_interval.tv_nsec = ( period % USLEEP_MAX ) * 1000;
+    spec.it_value.tv_sec += spec.it_interval.tv_sec;
+    spec.it_value.tv_nsec += spec.it_interval.tv_nsec;
+
+    if ( spec.it_value.tv_nsec >= USLEEP_MAX * 1000 )
+    {
+        spec.it_value.tv_sec++;
+        spec.it_value.tv_nsec -= USLEEP_MAX * 1000;
+    }
+
+    if ( ::timerfd_settime( m_timer, TFD_TIMER_ABSTIME, &spec, NULL ) < 0 )
+    {
+        LOGERRNO( flags, "Reactor::sTimer()->timerfd_settime()->" );
+        return false;
+    }
+
+    return true;
+}
+
+/* Internal */
+/**
+ * @brief Constructor for the Reactor class.
+ */
+Reactor::Reactor()
+{
+    m_descriptor = -1;
+    m_events.clear();
+    m_expired = 0;
+    m_ready = 0;
+    m_timer = -1;
+    m_wake = -1;
+
+    return;
+}
+
+/**
+ * @brief Destructor for the Reactor class.
+ */
+Reactor::~Reactor()
+{
+    UFLAGS_DE( flags );
+
+    if ( m_descriptor >= 0 && ::close( m_descriptor ) < 0 )
+        LOGERRNO( flags, "Reactor::~Reactor()->close()->" );
+
+    if ( m_timer >= 0 && ::close( m_timer ) < 0 )
+        LOGERRNO( flags, "Reactor::~Reactor()->close()->" );
+
+    if ( m_wake >= 0 && ::close( m_wake ) < 0 )
+        LOGERRNO( flags, "Reactor::~Reactor()->close()->" );
+
+    return;
+}
@@ -0,0 +1,335 @@
+/***************************************************************************
+ * NAMS - Not Another MUD Server                                           *
+ * Copyright (C) 2012 Matthew Goff (matt@goff.cc) <http://www.ackmud.net/> *
+ *                                                                         *
+ * This program is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU General Public License as published by    *
+ * the Free Software Foundation, either version 3 of the License, or       *
+ * (at your option) any later version.                                     *
+ *                                                                         *
+ * This program is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ * GNU General Public License for more details.                            *
+ *                                                                         *
+ * You should have received a copy of the GNU General Public License       *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ ***************************************************************************/
+/**
+ * @file resolver.cpp
+ * @brief All non-template member functions of the Resolver class.
+ *
+ * The game thread hands addresses to the Resolver and carries on; a fixed
+ * number of threads perform the lookups and leave each result behind for the
+ * game thread to collect via Resolver::Pop(). Results are addressed to a
+ * SocketClient by its handle within socket_client_list rather than a pointer,
+ * so a client which disconnects before its lookup completes is simply never
+ * found.
+ */
+#include "h/includes.h"
+#include "h/resolver.h"
+
+#include "h/reactor.h"
+
+/* Core */
+/**
+ * @brief Stop every thread in the pool and unload the Resolver from memory. Called from the game thread.
+ * @retval void
+ */
+const void Resolver::Delete()
+{
+    UFLAGS_DE( flags );
+    ITER( vector, pthread_t, ti );
+
+    ::pthread_mutex_lock( &m_mutex );
+    m_running = false;
+    ::pthread_cond_broadcast( &m_wake );
+    ::pthread_mutex_unlock( &m_mutex );
+
+    // A thread part way through a lookup finishes it first
+    for ( ti = m_threads.begin(); ti != m_threads.end(); ti++ )
+        if ( ::pthread_join( *ti, NULL ) != 0 )
+            LOGERRNO( flags, "Resolver::Delete()->pthread_join()->" );
+
+    delete this;
+
+    return;
+}
+
+/**
+ * @brief Find the hostname of an address. Called from the game thread.
+ * @param[in] handle The handle of the SocketClient within socket_client_list which the result should be delivered to if it isn't cached.
+ * @param[in] addr The numeric address to look up.
+ * @param[out] hostname The cached hostname of addr, or empty if the address is cached as having none.
+ * @retval false Returned if the address wasn't cached; the result will later be collected via Resolver::Pop().
+ * @retval true Returned if the result was found within the cache and hostname has been set.
+ */
+const bool Resolver::Lookup( const SlotHandle& handle, const string& addr, string& hostname )
+{
+    UFLAGS_DE( flags );
+    map<string,Resolver::Entry>::iterator ci;
+    map< string,vector<SlotHandle> >::iterator pi;
+    bool found = false, queued = true;
+
+    if ( addr.empty() )
+    {
+        LOGSTR( flags, "Resolver::Lookup()-> called with empty addr" );
+        return false;
+    }
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    if ( ( ci = m_cache.find( addr ) ) != m_cache.end() && ci->second.m_expires > chrono::steady_clock::now() )
+    {
+        m_recent.splice( m_recent.begin(), m_recent, ci->second.m_recent );
+        hostname = ci->second.m_hostname;
+        found = true;
+    }
+    // Clients connecting from an address already being looked up share the one lookup
+    else if ( ( pi = m_pending.find( addr ) ) != m_pending.end() )
+        pi->second.push_back( handle );
+    else if ( m_queue.size() < CFG_SOC_RESOLVE_QUEUE )
+    {
+        m_pending[addr].push_back( handle );
+        m_queue.push_back( addr );
+        ::pthread_cond_signal( &m_wake );
+    }
+    else
+        queued = false;
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    if ( !queued )
+        LOGFMT( flags, "Resolver::Lookup()-> queue is full, leaving %s unresolved", CSTR( addr ) );
+
+    return found;
+}
+
+/**
+ * @brief Start the threads of the pool.
+ * @retval false Returned if a thread was unable to be started.
+ * @retval true Returned if all #CFG_SOC_RESOLVE_THREADS threads were started.
+ */
+const bool Resolver::New()
+{
+    UFLAGS_DE( flags );
+    pthread_t thread;
+    uint_t i = 0;
+
+    m_running = true;
+
+    for ( i = 0; i < CFG_SOC_RESOLVE_THREADS; i++ )
+    {
+        if ( ::pthread_create( &thread, NULL, &Resolver::tUpdate, this ) != 0 )
+        {
+            LOGERRNO( flags, "Resolver::New()->pthread_create()->" );
+            return false;
+        }
+
+        m_threads.push_back( thread );
+    }
+
+    return true;
+}
+
+/**
+ * @brief Retrieve the next completed lookup. Called from the game thread.
+ * @param[out] result The handle of the SocketClient the lookup was made for, and the hostname found or empty if there was none.
+ * @retval false Returned if there are no completed lookups waiting.
+ * @retval true Returned if result has been set.
+ */
+const bool Resolver::Pop( pair<SlotHandle,string>& result )
+{
+    bool found = false;
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    if ( !m_results.empty() )
+    {
+        result = m_results.front();
+        m_results.pop_front();
+        found = true;
+    }
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    return found;
+}
+
+/**
+ * @brief Look up the hostname of an address via the host OS. This may block for as long as DNS takes to answer.
+ * @param[in] addr The numeric IPv4 or IPv6 address to look up.
+ * @param[out] hostname The hostname found for addr.
+ * @retval false Returned if addr isn't a numeric address or has no hostname.
+ * @retval true Returned if hostname was set.
+ */
+const bool Resolver::Reverse( const string& addr, string& hostname )
+{
+    UFLAGS_DE( flags );
+    static addrinfo hints_zero;
+    addrinfo hints = hints_zero;
+    addrinfo* info = NULL;
+    sint_t error = 0;
+    char buf[CFG_STR_MAX_BUFLEN] = {'\0'};
+
+    hints.ai_flags = AI_NUMERICHOST;
+
+    if ( ( error = ::getaddrinfo( CSTR( addr ), NULL, &hints, &info ) ) != 0 )
+    {
+        LOGFMT( flags, "Resolver::Reverse()->getaddrinfo()-> returned errno %d: %s", error, gai_strerror( error ) );
+        return false;
+    }
+
+    error = ::getnameinfo( info->ai_addr, info->ai_addrlen, buf, sizeof( buf ), NULL, 0, NI_NAMEREQD );
+    ::freeaddrinfo( info );
+
+    if ( error != 0 )
+    {
+        LOGFMT( flags, "Resolver::Reverse()->getnameinfo()-> %s returned errno %d: %s", CSTR( addr ), error, gai_strerror( error ) );
+        return false;
+    }
+
+    hostname = buf;
+
+    return true;
+}
+
+/**
+ * @brief Wait for an address to be queued, look it up, then cache the result and leave it for the game thread. Called from the pool.
+ * @retval false Returned once the pool has been asked to exit.
+ * @retval true Returned if an address was looked up.
+ */
+const bool Resolver::Update()
+{
+    map<string,Resolver::Entry>::iterator ci;
+    map< string,vector<SlotHandle> >::iterator pi;
+    ITER( vector, SlotHandle, hi );
+    Function function = NULL;
+    string addr, hostname;
+    bool resolved = false;
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    while ( m_running && m_queue.empty() )
+        ::pthread_cond_wait( &m_wake, &m_mutex );
+
+    if ( !m_running )
+    {
+        ::pthread_mutex_unlock( &m_mutex );
+        return false;
+    }
+
+    addr = m_queue.front();
+    m_queue.pop_front();
+    function = m_function;
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    if ( !( resolved = ( *function )( addr, hostname ) ) )
+        hostname.clear();
+
+    ::pthread_mutex_lock( &m_mutex );
+
+    if ( ( ci = m_cache.find( addr ) ) == m_cache.end() )
+    {
+        ci = m_cache.insert( make_pair( addr, Resolver::Entry() ) ).first;
+        m_recent.push_front( addr );
+        ci->second.m_recent = m_recent.begin();
+    }
+    else
+        m_recent.splice( m_recent.begin(), m_recent, ci->second.m_recent );
+
+    // Failures are retried sooner in case they were only a passing fault
+    ci->second.m_hostname = hostname;
+    ci->second.m_expires = chrono::steady_clock::now() + chrono::seconds( resolved ? CFG_SOC_RESOLVE_TTL : CFG_SOC_RESOLVE_NEGATIVE_TTL );
+
+    while ( m_cache.size() > CFG_SOC_RESOLVE_CACHE )
+    {
+        m_cache.erase( m_recent.back() );
+        m_recent.pop_back();
+    }
+
+    if ( ( pi = m_pending.find( addr ) ) != m_pending.end() )
+    {
+        for ( hi = pi->second.begin(); hi != pi->second.end(); hi++ )
+            m_results.push_back( make_pair( *hi, hostname ) );
+
+        m_pending.erase( pi );
+    }
+
+    ::pthread_mutex_unlock( &m_mutex );
+
+    g_global->m_reactor->Wake();
+
+    return true;
+}
+
+/* Query */
+
+/* Manipulate */
+/**
+ * @brief Replace the function used to perform lookups, such as with a local stub so that no network access is needed.
+ * @param[in] function The function to use for all future lookups.
+ * @retval void
+ */
+const void Resolver::sFunction( Function function )
+{
+    UFLAGS_DE( flags );
+
+    if ( function == NULL )
+    {
+        LOGSTR( flags, "Resolver::sFunction()-> called with NULL function" );
+        return;
+    }
+
+    ::pthread_mutex_lock( &m_mutex );
+    m_function = function;
+    ::pthread_mutex_unlock( &m_mutex );
+
+    return;
+}
+
+/**
+ * @brief The body of each thread in the pool.
+ * @param[in] data A self-reference passed via this to use for callback.
+ * @retval void
+ */
+void* Resolver::tUpdate( void* data )
+{
+    Resolver* resolver = reinterpret_cast<Resolver*>( data );
+
+    while ( resolver->Update() );
+
+    ::pthread_exit( reinterpret_cast<void*>( EXIT_SUCCESS ) );
+}
+
+/* Internal */
+/**
+ * @brief Constructor for the Resolver class.
+ */
+Resolver::Resolver()
+{
+    m_cache.clear();
+    m_function = &Resolver::Reverse;
+    ::pthread_mutex_init( &m_mutex, NULL );
+    m_pending.clear();
+    m_queue.clear();
+    m_recent.clear();
+    m_results.clear();
+    m_running = false;
+    m_threads.clear();
+    ::pthread_cond_init( &m_wake, NULL );
+
+    return;
+}
+
+/**
+ * @brief Destructor for the Resolver class.
+ */
+Resolver::~Resolver()
+{
+    ::pthread_cond_destroy( &m_wake );
+    ::pthread_mutex_destroy( &m_mutex );
+
+    return;
+}
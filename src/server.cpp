@@ -32,14 +32,21 @@
 
 #include "h/account.h"
 #include "h/aiprog.h"
+#include "h/atomtable.h"
 #include "h/brain.h"
 #include "h/character.h"
 #include "h/command.h"
 #include "h/event.h"
+#include "h/eventwheel.h"
 #include "h/exit.h"
+#include "h/hasher.h"
+#include "h/iothread.h"
 #include "h/list.h"
 #include "h/location.h"
 #include "h/object.h"
+#include "h/pool.h"
+#include "h/reactor.h"
+#include "h/resolver.h"
 #include "h/socketclient.h"
 #include "h/socketserver.h"
 
@@ -78,23 +85,20 @@ const void Server::Stats::Delete()
 }
 
 /**
- * @brief Sends a message to all clients connected to the Server.
+ * @brief Sends a message to all clients connected to the Server. The message is queued alongside everything else
+ * produced during the pulse and written by Server::PollSockets(), along with a single prompt.
  * @param[in] msg The message to be sent.
  * @retval void
  */
 const void Server::Broadcast( const string& msg )
 {
     SocketClient *client = NULL;
-    ITER( vector, SocketClient*, si );
+    size_t i = 0;
+    Segment segment = make_shared<const string>( Telopt::ProcessOutput( msg ) );
 
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
-    {
-        client = *si;
-        g_global->m_next_socket_client = ++si;
-
-        client->Send( msg );
-        client->Send();
-    }
+    for ( i = 0; i < socket_client_list.Length(); i++ )
+        if ( ( client = socket_client_list.At( i ) ) != NULL )
+            client->Send( segment );
 
     return;
 }
@@ -144,6 +148,27 @@ const bool Server::BuildPlugin( const string& file, const bool& force )
     return true;
 }
 
+/**
+ * @brief Release the memory of every Character and Object deleted since the last call.
+ * @retval void
+ */
+const void Server::FreeDeleted()
+{
+    while ( !character_delete_list.empty() )
+    {
+        delete character_delete_list.back();
+        character_delete_list.pop_back();
+    }
+
+    while ( !object_delete_list.empty() )
+    {
+        delete object_delete_list.back();
+        object_delete_list.pop_back();
+    }
+
+    return;
+}
+
 /**
  * @brief Links Exit pointers together after all locations are loaded.
  * @retval void
@@ -154,8 +179,7 @@ const void Server::LinkExits()
     chrono::high_resolution_clock::time_point start, finish;
     double duration = uintmin_t;
     ITER( vector, Location*, li );
-    ITER( vector, Exit*, ei );
-    vector<Exit*> loc_exits;
+    vector<Exit*>::size_type i = 0;
     Location* destination = NULL;
     Location* location = NULL;
     Exit* exit = NULL;
@@ -166,16 +190,16 @@ const void Server::LinkExits()
     for ( li = location_list.begin(); li != location_list.end(); li++ )
     {
         location = *li;
-        loc_exits = location->gExits();
 
-        for ( ei = loc_exits.begin(); ei != loc_exits.end(); ei++ )
+        // Invalid exits are removed along the way, so walk the live list rather than a copy of it
+        for ( i = 0; i < location->gExits().size(); Utils::Advance( location->gExits(), i, exit ) )
         {
-            exit = *ei;
+            exit = location->gExits()[i];
 
             if ( ( destination = Handler::FindLocation( exit->gDestId(), HANDLER_FIND_ID ) ) == NULL )
             {
                 LOGFMT( flags, "Server::LinkExits()-> location %s has invalid exit to %s", CSTR( location->gId() ), CSTR( exit->gDestId() ) );
-                location->RemoveExit( exit );
+                // Deleting the Exit also removes it from the Location
                 exit->Delete();
             }
             else
@@ -391,24 +415,22 @@ const bool Server::LoadObjects()
 }
 
 /**
- * @brief Poll all SocketClient objects that are communicating with the associated SocketServer object.
+ * @brief Wake the IOThread objects for anything handed to them, then wait for and process new connections and notices from the IOThread objects.
  * @retval false Returned if the file descriptor of the SocketServer is invalid and no further processing can take place.
  * @retval true Returned if the file descriptor of the SocketServer is valid and all SocketClient objects were polled successfully.
  */
 const bool Server::PollSockets()
 {
     UFLAGS_DE( flags );
-    static timespec static_time;
-    fd_set exc_set;
-    fd_set in_set;
-    fd_set out_set;
-    ITER( vector, SocketClient*, si );
-    SocketClient* socket_client;
-    sint_t client_desc = 0, max_desc = 0, server_desc = 0;
-
-    FD_ZERO( &exc_set );
-    FD_ZERO( &in_set );
-    FD_ZERO( &out_set );
+    ITER( vector, IOThread*, ii );
+    pair<SocketClient*,uint_t> notice;
+    pair<SlotHandle,string> resolved;
+    Hasher::Job hashed;
+    SocketClient* socket_client = NULL;
+    SocketServer* socket_server = NULL;
+    Socket* socket = NULL;
+    sint_t client_desc = 0, ready = 0, server_desc = 0;
+    uint_t i = 0;
 
     if ( ( server_desc = g_global->m_listen->gDescriptor() ) < 1 )
     {
@@ -416,173 +438,150 @@ const bool Server::PollSockets()
         return false;
     }
 
-    FD_SET( server_desc, &in_set );
-    max_desc = server_desc;
+    // Everything posted since the last pass is handed over with a single wake-up per thread
+    for ( ii = g_global->m_io_threads.begin(); ii != g_global->m_io_threads.end(); ii++ )
+        ( *ii )->Wake();
 
-    // Build three file descriptor lists to be polled
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
+    // Block until a connection is pending, an IOThread has news, or the next pulse is due
+    if ( ( ready = g_global->m_reactor->Wait( -1 ) ) < 0 )
     {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
+        LOGSTR( flags, "Server::PollSockets()->Reactor::Wait()-> returned an error" );
+        return false;
+    }
 
-        if ( ( client_desc = socket_client->gDescriptor() ) < 1 )
-        {
-            LOGFMT( flags, "Server::PollSockets()->SocketClient::gDescriptor()-> returned invalid descriptor: %ld", client_desc );
-            socket_client->Delete();
+    for ( i = 0; i < static_cast<uint_t>( ready ); i++ )
+    {
+        // Timer and wake-up events
+        if ( ( socket = g_global->m_reactor->gSocket( i ) ) == NULL )
             continue;
-        }
 
-        if ( socket_client->Quitting() )
+        // Process new connections
+        if ( ( socket_server = dynamic_cast<SocketServer*>( socket ) ) != NULL )
         {
-            socket_client->Send();
-            socket_client->Delete();
+            socket_server->Accept();
             continue;
         }
 
-        max_desc = max( max_desc, client_desc );
-
-        // Populate lists of: exceptions, pending input, pending output
-        FD_SET( client_desc, &exc_set );
-        FD_SET( client_desc, &in_set );
-        FD_SET( client_desc, &out_set );
+        LOGFMT( flags, "Server::PollSockets()->Reactor::gSocket()-> returned unknown socket for descriptor: %ld", socket->gDescriptor() );
     }
 
-    // Ensure the file descriptor lists can be watched for updates
-    if ( ::pselect( max_desc + 1, &in_set, &out_set, &exc_set, &static_time, 0 ) < 0 )
+    for ( ii = g_global->m_io_threads.begin(); ii != g_global->m_io_threads.end(); ii++ )
     {
-        LOGERRNO( flags, "Server::PollSockets()->pselect()->" );
-        return false;
-    }
+        while ( ( *ii )->Pop( notice ) )
+        {
+            socket_client = notice.first;
+            client_desc = socket_client->gDescriptor();
 
-    // Process new connections
-    if ( FD_ISSET( server_desc, &in_set ) )
-        g_global->m_listen->Accept();
+            switch ( notice.second )
+            {
+                // The connection failed while reading or writing; save game character and disconnect socket
+                case SOC_IO_HANGUP:
+                    LOGFMT( flags, "Server::PollSockets()->IOThread::Pop()-> descriptor %ld hung up", client_desc );
 
-    // Process faulted connections
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
-    {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
+                    // Detach the Character as linkdead
+                    if ( socket_client->gState() >= SOC_STATE_PLAYING )
+                    {
+                        if ( socket_client->gAccount() != NULL )
+                        {
+                            if ( socket_client->gAccount()->gCharacter() != NULL )
+                            {
+                                Event* event = new Event();
+
+                                socket_client->sState( SOC_STATE_DISC_LINKDEAD );
+                                socket_client->gAccount()->gCharacter()->gBrain()->sAccount( NULL );
+                                event->New( "quit", "quit", socket_client->gAccount()->gCharacter(), Handler::FindCommand( "quit" ), EVENT_TYPE_CMD_CHARACTER, CFG_CHR_MAX_IDLE );
+                                socket_client->gAccount()->sCharacter( NULL );
+                            }
+                        }
+                    }
 
-        if ( ( client_desc = socket_client->gDescriptor() ) < 1 )
-        {
-            LOGFMT( flags, "Server::PollSockets()->SocketClient::gDescriptor()-> returned invalid descriptor: %ld", client_desc );
-            socket_client->Delete();
-            continue;
-        }
+                    socket_client->Delete();
+                break;
 
-        // Found a faulted socket in the exceptions list
-        if ( FD_ISSET( client_desc, &exc_set ) )
-        {
-            // Don't try to save characters on faulty clients, just boot them
-            LOGFMT( flags, "Server::PollSockets()-> disconnecting faulted descriptor: %ld", client_desc );
-            socket_client->Delete();
-            continue;
-        }
-    }
+                // Run the first command of this pulse as soon as it arrives rather than waiting for the pulse to end
+                case SOC_IO_INPUT:
+                    if ( !socket_client->ProcessInput() )
+                    {
+                        LOGFMT( flags, "Server::PollSockets()->SocketClient::ProcessInput()-> descriptor %ld returned false", client_desc );
+                        socket_client->Delete();
+                        // @todo save character
+                        break;
+                    }
 
-    // Process input from active connections
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
-    {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
+                    if ( socket_client->gCommandsRun() != 0 || !socket_client->PendingCommand() )
+                        break;
 
-        if ( ( client_desc = socket_client->gDescriptor() ) < 1 )
-        {
-            LOGFMT( flags, "Server::PollSockets()->SocketClient::gDescriptor()-> returned invalid descriptor: %ld", client_desc );
-            // @todo save character
-            socket_client->Delete();
-            continue;
-        }
+                    if ( !socket_client->ProcessCommand() )
+                    {
+                        LOGFMT( flags, "Server::PollSockets()->SocketClient::ProcessCommand()-> descriptor %ld returned false", client_desc );
+                        socket_client->Delete();
+                        // @todo save character
+                        break;
+                    }
 
-        // Found an active socket in the input list
-        if ( FD_ISSET( client_desc, &in_set ) )
-        {
-            // Pending input; clear the idle timeout
-            if ( !socket_client->sIdle( 0 ) )
-            {
-                LOGFMT( flags, "Server::PollSockets()->SocketClient::sIdle()-> descriptor %ld returned false setting idle: 0", client_desc );
-                // @todo save character
-                socket_client->Delete();
-                continue;
-            }
+                    // Only the client whose command ran is answered now; anyone else it reached hears at the end of the pulse
+                    if ( !socket_client->gOutputPending() || socket_client->Quitting() )
+                        break;
 
-            // Read input, save game character and disconnect socket if unable to
-            if ( !socket_client->Recv() )
-            {
-                LOGFMT( flags, "Server::PollSockets()->SocketClient::Recv()-> descriptor %ld returned false", client_desc );
+                    socket_client->sOutputPending( false );
 
-                // Detach the Character as linkdead
-                if ( socket_client->gState() >= SOC_STATE_PLAYING )
-                {
-                    if ( socket_client->gAccount() != NULL )
+                    if ( socket_client->PendingOutput() && !socket_client->Send() )
                     {
-                        if ( socket_client->gAccount()->gCharacter() != NULL )
-                        {
-                            Event* event = new Event();
-
-                            socket_client->sState( SOC_STATE_DISC_LINKDEAD );
-                            socket_client->gAccount()->gCharacter()->gBrain()->sAccount( NULL );
-                            event->New( "quit", "quit", socket_client->gAccount()->gCharacter(), Handler::FindCommand( "quit" ), EVENT_TYPE_CMD_CHARACTER, CFG_CHR_MAX_IDLE );
-                            socket_client->gAccount()->sCharacter( NULL );
-                        }
+                        LOGFMT( flags, "Server::PollSockets()->SocketClient::PendingOutput()->SocketClient::Send()-> descriptor %ld returned false", client_desc );
+                        socket_client->Delete();
+                        // @todo save character
                     }
-                }
+                break;
 
-                socket_client->Delete();
-                continue;
-            }
-        }
-        else
-        {
-            if ( !socket_client->sIdle( socket_client->gIdle() + 1 ) )
-            {
-                LOGFMT( flags, "Server::PollSockets()->SocketClient::sIdle()-> descriptor %ld returned false setting idle: %lu", client_desc, socket_client->gIdle() + 1 );
-                // @todo save character
-                socket_client->Delete();
-                continue;
+                default:
+                    LOGFMT( flags, "Server::PollSockets()->IOThread::Pop()-> returned invalid notice type: %lu", notice.second );
+                break;
             }
         }
     }
 
-    // Process any pending output
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
+    // Completed hostname lookups; the client may have disconnected while waiting, in which case it is no longer found
+    while ( g_global->m_resolver->Pop( resolved ) )
     {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
+        if ( resolved.second.empty() || ( socket_client = socket_client_list.Get( resolved.first ) ) == NULL )
+            continue;
 
-        if ( ( client_desc = socket_client->gDescriptor() ) < 1 )
-        {
-            LOGFMT( flags, "Server::PollSockets()->SocketClient::gDescriptor()-> returned invalid descriptor: %ld", client_desc );
-            // @todo save character
-            socket_client->Delete();
+        if ( !socket_client->sHostname( resolved.second ) )
+            LOGFMT( flags, "Server::PollSockets()->SocketClient::sHostname()-> hostname %s returned false", CSTR( resolved.second ) );
+        else
+            LOGFMT( 0, "SocketClient::ResolveHostname()-> %s (%lu)", CSTR( socket_client->gHostname() ), socket_client->gDescriptor() );
+    }
+
+    // Passwords that have been hashed resume the login of their client
+    while ( g_global->m_hasher->Pop( hashed ) )
+    {
+        if ( ( socket_client = socket_client_list.Get( hashed.m_handle ) ) == NULL )
             continue;
-        }
 
-        // Disconnect sockets that have been idle for too long
-        if ( socket_client->gIdle() >= CFG_SOC_MAX_IDLE )
+        Handler::PasswordVerified( socket_client, hashed.m_state, hashed.m_hash );
+    }
+
+    // Disconnect sockets that have been idle for too long; only checked once per second rather than every pulse
+    if ( g_global->m_pulse - g_global->m_idle_check >= CFG_GAM_PULSE_RATE )
+    {
+        g_global->m_idle_check = g_global->m_pulse;
+
+        for ( i = 0; i < socket_client_list.Length(); i++ )
         {
+            if ( ( socket_client = socket_client_list.At( i ) ) == NULL )
+                continue;
+
+            if ( socket_client->gIdle() < CFG_SOC_MAX_IDLE )
+                continue;
+
             // Disable the idle timeout for admins
             if ( socket_client->gAccount() && socket_client->gAccount()->gSecurity() >= ACT_SECURITY_ADMIN )
                 continue;
-            LOGFMT( flags, "Server::PollSockets()->SocketClient::gIdle()-> disconnecting idle descriptor: %ld", client_desc );
+
+            LOGFMT( flags, "Server::PollSockets()->SocketClient::gIdle()-> disconnecting idle descriptor: %ld", socket_client->gDescriptor() );
             socket_client->Send( CFG_STR_IDLE );
             socket_client->Delete();
             // @todo save character
-            continue;
-        }
-
-        // Found an active socket in the output list
-        if ( FD_ISSET( client_desc, &out_set ) && socket_client->PendingOutput() )
-        {
-            // Send output, save game character and disconnect socket if unable to
-            if ( !socket_client->Send() )
-            {
-                LOGFMT( flags, "Server::PollSockets()->SocketClient::PendingOutput()->SocketClient::Send()-> descriptor %ld returned false", client_desc );
-                socket_client->Delete();
-                // @todo save character
-                continue;
-            }
         }
     }
 
@@ -595,36 +594,30 @@ const bool Server::PollSockets()
  */
 const void Server::ProcessEvents()
 {
-    ITER( vector, Event*, ei );
-    Event* event;
-
-    for ( ei = event_list.begin(); ei != event_list.end(); ei = g_global->m_next_event )
-    {
-        event = *ei;
-        g_global->m_next_event = ++ei;
-
-        if ( !event->Update() )
-            event->Run();
-    }
+    g_global->m_event_wheel->Update();
 
     return;
 }
 
 /**
- * @brief Processes input from all active SocketClient objects.
+ * @brief Processes input from all active SocketClient objects, then runs their queued commands. Preempt commands are run
+ * straight away; the rest are run in round-robin order, up to #CFG_GAM_CMD_BURST per client and #CFG_GAM_CMD_BUDGET in total.
  * @retval void
  */
 const void Server::ProcessInput()
 {
     UFLAGS_DE( flags );
-    ITER( vector, SocketClient*, si );
+    ITER( vector, SlotHandle, hi );
     SocketClient* socket_client;
+    vector<SlotHandle> ready;
+    size_t i = 0;
     sint_t client_desc = 0;
+    uint_t budget = CFG_GAM_CMD_BUDGET;
 
-    for ( si = socket_client_list.begin(); si != socket_client_list.end(); si = g_global->m_next_socket_client )
+    for ( i = 0; i < socket_client_list.Length(); i++ )
     {
-        socket_client = *si;
-        g_global->m_next_socket_client = ++si;
+        if ( ( socket_client = socket_client_list.At( i ) ) == NULL )
+            continue;
 
         if ( ( client_desc = socket_client->gDescriptor() ) < 1 )
         {
@@ -642,15 +635,99 @@ const void Server::ProcessInput()
             continue;
         }
 
-        if ( socket_client->PendingCommand() )
+        // Preempt commands skip the queue and the budget
+        while ( socket_client->PendingPreempt() && !socket_client->Closing() )
+        {
+            if ( !socket_client->ProcessCommand() )
+            {
+                LOGFMT( flags, "Server::ProcessInput()->SocketClient::PendingPreempt()->SocketClient::ProcessCommand()-> descriptor %ld returned false", client_desc );
+                // @todo save character
+                socket_client->Delete();
+            }
+        }
+
+        if ( !socket_client->Closing() && socket_client->PendingCommand() )
+            ready.push_back( socket_client->gListHandle() );
+    }
+
+    // Start from a different client each pulse so that none are always served first
+    if ( !ready.empty() )
+        rotate( ready.begin(), ready.begin() + g_global->m_pulse % ready.size(), ready.end() );
+
+    // Each round runs one command for every client that still has one, until the budget is spent
+    while ( budget > 0 && !ready.empty() )
+    {
+        for ( hi = ready.begin(); hi != ready.end() && budget > 0; )
         {
+            // A command run earlier this pulse may have disconnected the client, so only trust the handle
+            if ( ( socket_client = socket_client_list.Get( *hi ) ) == NULL || socket_client->Closing() || !socket_client->PendingCommand() )
+            {
+                hi = ready.erase( hi );
+                continue;
+            }
+
+            budget--;
+
             if ( !socket_client->ProcessCommand() )
             {
-                LOGFMT( flags, "Server::ProcessInput()->SocketClient::PendingCommand()->SocketClient::ProcessCommand()-> descriptor %ld returned false", client_desc );
+                LOGFMT( flags, "Server::ProcessInput()->SocketClient::PendingCommand()->SocketClient::ProcessCommand()-> descriptor %ld returned false", socket_client->gDescriptor() );
                 // @todo save character
                 socket_client->Delete();
+                hi = ready.erase( hi );
                 continue;
             }
+
+            hi++;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Hands the output gathered over the pulse to the IOThread objects, one piece and one prompt per client, and disconnects
+ * any client which is quitting. The IOThread objects are woken once Server::PollSockets() is next called.
+ * @retval void
+ */
+const void Server::ProcessOutput()
+{
+    UFLAGS_DE( flags );
+    vector<SlotHandle> pending;
+    ITER( vector, SlotHandle, si );
+    SocketClient* socket_client = NULL;
+    sint_t client_desc = 0;
+
+    // Only clients that queued data or are quitting since the last pulse are visited
+    pending.swap( socket_client_output_list );
+    for ( si = pending.begin(); si != pending.end(); si++ )
+    {
+        // Deleted since it was queued, or already visited through an earlier copy of its handle
+        if ( ( socket_client = socket_client_list.Get( *si ) ) == NULL || !socket_client->gOutputPending() )
+            continue;
+
+        socket_client->sOutputPending( false );
+
+        if ( ( client_desc = socket_client->gDescriptor() ) < 1 )
+        {
+            LOGFMT( flags, "Server::ProcessOutput()->SocketClient::gDescriptor()-> returned invalid descriptor: %ld", client_desc );
+            socket_client->Delete();
+            continue;
+        }
+
+        if ( socket_client->Quitting() )
+        {
+            socket_client->Send();
+            socket_client->Delete();
+            continue;
+        }
+
+        // Send output, save game character and disconnect socket if unable to
+        if ( socket_client->PendingOutput() && !socket_client->Send() )
+        {
+            LOGFMT( flags, "Server::ProcessOutput()->SocketClient::PendingOutput()->SocketClient::Send()-> descriptor %ld returned false", client_desc );
+            socket_client->Delete();
+            // @todo save character
+            continue;
         }
     }
 
@@ -690,6 +767,8 @@ const void Server::RebootRecovery( const bool& reboot )
             {
                 client = new SocketClient();
                 client->New( atoi( CSTR( value ) ), true );
+                // Compression state doesn't survive the reboot, so it is offered again from scratch
+                Telopt::Send( client, (char)WILL, (char)TELOPT_COMPRESS2 );
             }
             else if ( key == "port" )
                 client->sPort( atoi( CSTR( value ) ) );
@@ -776,6 +855,7 @@ const bool Server::ReloadCommand( const string& name )
 const void Server::Shutdown( const sint_t& status )
 {
     bool was_running = !g_global->m_shutdown;
+    size_t i = 0;
 
     Broadcast( CFG_STR_SHUTDOWN );
     g_global->m_shutdown = true;
@@ -795,9 +875,6 @@ const void Server::Shutdown( const sint_t& status )
     // Cleanup commands
     while ( !command_list.empty() )
         command_list.front()->Delete();
-    // Cleanup events
-    while ( !event_list.empty() )
-        event_list.front()->Delete();
     // Cleanup exits
     while ( !exit_list.empty() )
         exit_list.front()->Delete();
@@ -805,14 +882,20 @@ const void Server::Shutdown( const sint_t& status )
     while ( !location_list.empty() )
         location_list.front()->Delete();
     // Cleanup object copies
-    while ( !object_list.empty() )
-        object_list.front()->Delete();
+    for ( i = 0; i < object_list.Length(); i++ )
+        if ( object_list.At( i ) != NULL )
+            object_list.At( i )->Delete();
+    object_list.Compact();
     // Cleanup object templates
     while ( !object_template_list.empty() )
         object_template_list.front()->Delete();
     // Cleanup socket clients
-    while ( !socket_client_list.empty() )
-        socket_client_list.front()->Delete();
+    for ( i = 0; i < socket_client_list.Length(); i++ )
+        if ( socket_client_list.At( i ) != NULL )
+            socket_client_list.At( i )->Delete();
+    socket_client_list.Compact();
+    // Release everything deleted above
+    FreeDeleted();
 
     // Only output if the server actually booted; otherwise it probably faulted while getting a port from main()
     if ( was_running )
@@ -838,8 +921,10 @@ const void Server::Shutdown( const sint_t& status )
 const void Server::Startup( const sint_t& desc )
 {
     UFLAGS_DE( flags );
+    IOThread* io_thread = NULL;
     SocketServer* socket_server = NULL;
     sint_t descriptor = 0;
+    uint_t i = 0;
     bool reboot = false;
     g_global->m_shutdown = false;
 
@@ -860,8 +945,92 @@ const void Server::Startup( const sint_t& desc )
         reboot = true;
     }
 
+    g_global->m_reactor = new Reactor();
+
+    if ( !g_global->m_reactor->New() )
+    {
+        LOGSTR( flags, "Server::Startup()->Reactor::New()-> returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    if ( !g_global->m_reactor->sTimer( CFG_GAM_PULSE_RATE ) )
+    {
+        LOGSTR( flags, "Server::Startup()->Reactor::sTimer()-> returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    for ( i = 0; i < CFG_SOC_IO_THREADS; i++ )
+    {
+        io_thread = new IOThread();
+        g_global->m_io_threads.push_back( io_thread );
+
+        if ( !io_thread->New() )
+        {
+            LOGSTR( flags, "Server::Startup()->IOThread::New()-> returned false" );
+            Shutdown( EXIT_FAILURE );
+        }
+    }
+
+    // Created ahead of anything which may load a Thing
+    g_global->m_atom_table = new AtomTable();
+
+    if ( !g_global->m_atom_table->New() )
+    {
+        LOGSTR( flags, "Server::Startup()->AtomTable::New()-> returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    g_global->m_event_pool = new Pool();
+
+    if ( !g_global->m_event_pool->New( "Event", sizeof( Event ) ) )
+    {
+        LOGSTR( flags, "Server::Startup()->Pool::New()-> Event returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    g_global->m_exit_pool = new Pool();
+
+    if ( !g_global->m_exit_pool->New( "Exit", sizeof( Exit ) ) )
+    {
+        LOGSTR( flags, "Server::Startup()->Pool::New()-> Exit returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    g_global->m_object_pool = new Pool();
+
+    if ( !g_global->m_object_pool->New( "Object", sizeof( Object ) ) )
+    {
+        LOGSTR( flags, "Server::Startup()->Pool::New()-> Object returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    g_global->m_event_wheel = new EventWheel();
+
+    if ( !g_global->m_event_wheel->New() )
+    {
+        LOGSTR( flags, "Server::Startup()->EventWheel::New()-> returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    g_global->m_hasher = new Hasher();
+
+    if ( !g_global->m_hasher->New() )
+    {
+        LOGSTR( flags, "Server::Startup()->Hasher::New()-> returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
+    g_global->m_resolver = new Resolver();
+
+    if ( !g_global->m_resolver->New() )
+    {
+        LOGSTR( flags, "Server::Startup()->Resolver::New()-> returned false" );
+        Shutdown( EXIT_FAILURE );
+    }
+
     socket_server = new SocketServer();
     g_global->m_listen = socket_server;
+    g_global->m_listeners.push_back( socket_server );
 
     if ( !socket_server->New( descriptor, reboot ) )
     {
@@ -869,6 +1038,28 @@ const void Server::Startup( const sint_t& desc )
         Shutdown( EXIT_FAILURE );
     }
 
+    // Extra listeners are never carried across a reboot; they close on exec and are bound afresh here
+    for ( i = 1; i < CFG_SOC_LISTENERS; i++ )
+    {
+        if ( ( descriptor = ::socket( AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0 ) ) < 0 )
+        {
+            LOGERRNO( flags, "Server::Startup()->socket()->" );
+            break;
+        }
+
+        socket_server = new SocketServer();
+
+        // The primary listener may predate SO_REUSEPORT if the server was rebooted into a new configuration
+        if ( !socket_server->New( descriptor ) )
+        {
+            LOGSTR( flags, "Server::Startup()->SocketServer::New()-> returned false" );
+            socket_server->Delete();
+            break;
+        }
+
+        g_global->m_listeners.push_back( socket_server );
+    }
+
     // Bump ourselves to the root folder for file paths
     if ( !reboot && ::chdir( ".." ) < 0 )
     {
@@ -919,30 +1110,59 @@ const void Server::Startup( const sint_t& desc )
 }
 
 /**
- * @brief The core update loop of NAMS. This loop spawns all other subsystem update routines and then sleeps for ( #USLEEP_MAX / #CFG_GAM_PULSE_RATE ) each cycle.
+ * @brief The core update loop of NAMS. Socket activity is serviced as it arrives until the next pulse deadline passes,
+ * then all other subsystem update routines are run. Deadlines fall every ( #USLEEP_MAX / #CFG_GAM_PULSE_RATE ) on an
+ * absolute schedule, so the time spent working is never added on top of the pulse length.
  * @retval void
  */
 const void Server::Update()
 {
     UFLAGS_DE( flags );
+    ITER( vector, SocketServer*, li );
+    uint_t expired = 0, i = 0;
+
+    // Poll all sockets for changes until the next pulse is due
+    do
+    {
+        g_global->m_time_current = chrono::high_resolution_clock::now();
 
-    g_global->m_time_current = chrono::high_resolution_clock::now();
+        if ( !PollSockets() )
+        {
+            LOGSTR( flags, "Server::Update()->Server::PollSockets()-> returned false" );
+            Shutdown( EXIT_FAILURE );
+        }
+    } while ( ( expired = g_global->m_reactor->gExpired() ) == 0 );
 
-    // Poll all sockets for changes
-    if ( !PollSockets() )
+    // More than one deadline passed since the last pulse; the previous pulse took too long
+    if ( expired > 1 )
     {
-        LOGSTR( flags, "Server::Update()->Server::PollSockets()-> returned false" );
-        Shutdown( EXIT_FAILURE );
+        LOGFMT( flags, "Server::Update()-> pulse %lu overran by %lu pulses", g_global->m_pulse, expired - 1 );
+        g_stats->sPulseOverrun( g_stats->gPulseOverrun() + expired - 1 );
     }
 
     // Process any input received
     ProcessInput();
 
-    // Process any scheduled events
-    ProcessEvents();
+    // Process any scheduled events; missed pulses are caught up so event timing stays accurate
+    for ( i = 0; i < expired; i++ )
+    {
+        g_global->m_pulse++;
+        ProcessEvents();
+    }
+
+    // Everything the pulse produced goes out together, after all of its commands and events have run
+    ProcessOutput();
 
-    // Sleep to control game pacing
-    ::usleep( USLEEP_MAX / CFG_GAM_PULSE_RATE );
+    // Listeners that spent their accept budget resume with a fresh one
+    for ( li = g_global->m_listeners.begin(); li != g_global->m_listeners.end(); li++ )
+        if ( ( *li )->gPaused() && !( *li )->sPaused( false ) )
+            LOGFMT( flags, "Server::Update()->SocketServer::sPaused()-> descriptor %ld returned false", ( *li )->gDescriptor() );
+
+    // Nothing walks the lists between pulses, so this is where the gaps left by anything deleted during the pulse are closed
+    character_list.Compact();
+    object_list.Compact();
+    socket_client_list.Compact();
+    FreeDeleted();
 
     return;
 }
@@ -975,6 +1195,33 @@ vector<string> Server::Config::gProhibitedNames( const uint_t& type ) const
     return m_prohibited_names[type];
 }
 
+/**
+ * @brief Returns the number of commands ignored for exceeding a client's command rate or queue depth.
+ * @retval uint_t The total number of commands ignored.
+ */
+const uint_t Server::Stats::gInputDropped() const
+{
+    return m_input_dropped;
+}
+
+/**
+ * @brief Returns the number of times a client's reads were paused for exceeding #CFG_SOC_INPUT_BYTE_RATE.
+ * @retval uint_t The number of times reads were paused.
+ */
+const uint_t Server::Stats::gInputLimited() const
+{
+    return m_input_limited;
+}
+
+/**
+ * @brief Returns the number of pulse deadlines that passed before the Server was able to service them.
+ * @retval uint_t The total number of missed pulse deadlines.
+ */
+const uint_t Server::Stats::gPulseOverrun() const
+{
+    return m_pulse_overrun;
+}
+
 /**
  * @brief Returns the combined number of SocketClient and SocketServer objects that have been destroyed.
  * @retval uint_t The total number of closed sockets that were tied to this object.
@@ -1023,7 +1270,7 @@ const string Server::gHostname()
  */
 const string Server::gStatus()
 {
-    string output;
+    string output, ratio;
     uint_t i = 0, x = 0;
 
     // Header
@@ -1041,15 +1288,22 @@ const string Server::gStatus()
     // Memory info
     output += CRLF "Objects in Memory" CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu AI Programs", aiprog_list.size() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Atoms", g_global->m_atom_table->gSize() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Brains", brain_list.size() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Commands", command_list.size() ) + CRLF;
-    output += "    " + Utils::FormatString( 0, "%-5lu Events", event_list.size() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Events", g_global->m_event_wheel->gSize() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Exits", exit_list.size() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Locations", location_list.size() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Character Templates", character_template_list.size() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Object Templates", object_template_list.size() ) + CRLF;
-    output += "    " + Utils::FormatString( 0, "%-5lu Unique Characters", character_list.size() ) + CRLF;
-    output += "    " + Utils::FormatString( 0, "%-5lu Unique Objects", object_list.size() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Unique Characters", character_list.Size() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Unique Objects", object_list.Size() ) + CRLF;
+
+    // Pool info
+    output += CRLF "Memory Pools" CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Events In Use, %lu Free, %lu Blocks, %lu Allocations", g_global->m_event_pool->gInUse(), g_global->m_event_pool->gFree(), g_global->m_event_pool->gBlocks(), g_global->m_event_pool->gAllocations() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Exits In Use, %lu Free, %lu Blocks, %lu Allocations", g_global->m_exit_pool->gInUse(), g_global->m_exit_pool->gFree(), g_global->m_exit_pool->gBlocks(), g_global->m_exit_pool->gAllocations() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Objects In Use, %lu Free, %lu Blocks, %lu Allocations", g_global->m_object_pool->gInUse(), g_global->m_object_pool->gFree(), g_global->m_object_pool->gBlocks(), g_global->m_object_pool->gAllocations() ) + CRLF;
 
     //Runtime statistics
     output += CRLF "Runtime Statistics" CRLF;
@@ -1057,6 +1311,21 @@ const string Server::gStatus()
     output += "    " + Utils::FormatString( 0, "%-5lu Total Directories Closed", g_stats->m_dir_close ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Total Sockets Opened", g_stats->gSocketOpen() ) + CRLF;
     output += "    " + Utils::FormatString( 0, "%-5lu Total Sockets Closed", g_stats->gSocketClose() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Pulses Overrun", g_stats->gPulseOverrun() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Commands Dropped", g_stats->gInputDropped() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Reads Rate Limited", g_stats->gInputLimited() ) + CRLF;
+
+    // Network info
+    output += CRLF "Network Statistics" CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Bytes Received", g_global->m_listen->gBytesRecvd() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Bytes Sent", g_global->m_listen->gBytesSent() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Bytes Compressed", g_global->m_listen->gBytesUncompressed() ) + CRLF;
+    output += "    " + Utils::FormatString( 0, "%-5lu Total Bytes After Compression", g_global->m_listen->gBytesCompressed() ) + CRLF;
+    if ( g_global->m_listen->gBytesUncompressed() > 0 )
+    {
+        ratio = Utils::FormatString( 0, "%.0f%%", ( g_global->m_listen->gBytesCompressed() * 100.0 ) / g_global->m_listen->gBytesUncompressed() );
+        output += "    " + Utils::FormatString( 0, "%-5s Compression Ratio", CSTR( ratio ) ) + CRLF;
+    }
 
     return output;
 }
@@ -1237,6 +1506,69 @@ const bool Server::Config::Unserialize()
     return true;
 }
 
+/**
+ * @brief Increment the number of times a client's reads were paused for exceeding #CFG_SOC_INPUT_BYTE_RATE. Called from the I/O threads.
+ * @param[in] amount The amount to increase Server::Stats::m_input_limited by.
+ * @retval false Returned if the existing counter would overflow.
+ * @retval true Returned if the counter was successfully incremented.
+ */
+const bool Server::Stats::aInputLimited( const uint_t& amount )
+{
+    UFLAGS_DE( flags );
+
+    if ( amount < uintmin_t || ( ( m_input_limited + amount ) >= uintmax_t ) )
+    {
+        LOGFMT( flags, "Server::Stats::aInputLimited()-> called with m_input_limited overflow: %lu + %lu", m_input_limited.load(), amount );
+        return false;
+    }
+
+    m_input_limited += amount;
+
+    return true;
+}
+
+/**
+ * @brief Set the number of commands ignored for exceeding a client's command rate or queue depth.
+ * @param[in] amount The amount that Server::Stats::m_input_dropped should be set to.
+ * @retval false Returned if amount is outside the boundaries of a uint_t variable.
+ * @retval true Returned if the value was successfully set.
+ */
+const bool Server::Stats::sInputDropped( const uint_t& amount )
+{
+    UFLAGS_DE( flags );
+
+    if ( amount < uintmin_t || amount >= uintmax_t )
+    {
+        LOGFMT( flags, "Server::Stats::sInputDropped()-> called with m_input_dropped overflow: %lu + %lu", m_input_dropped, amount );
+        return false;
+    }
+
+    m_input_dropped = amount;
+
+    return true;
+}
+
+/**
+ * @brief Set the amount of pulse deadlines that have been missed on a NAMS Server object.
+ * @param[in] amount The amount that Server::m_pulse_overrun should be set to.
+ * @retval false Returned if amount is outside the boundaries of a uint_t variable.
+ * @retval true Returned if amount is within the boundaries of a uint_t variable.
+ */
+const bool Server::Stats::sPulseOverrun( const uint_t& amount )
+{
+    UFLAGS_DE( flags );
+
+    if ( amount < uintmin_t || amount >= uintmax_t )
+    {
+        LOGFMT( flags, "Server::Stats::sPulseOverrun()-> called with m_pulse_overrun overflow: %lu + %lu", m_pulse_overrun, amount );
+        return false;
+    }
+
+    m_pulse_overrun = amount;
+
+    return true;
+}
+
 /**
  * @brief Set the amount of subordinate SocketClient and SocketServer objects that have been closed on a NAMS Server object.
  * @param[in] amount The amount that Server::m_socket_close should be set to.
@@ -1307,12 +1639,21 @@ Server::Config::~Config()
  */
 Server::Global::Global()
 {
+    m_atom_table = NULL;
+    m_command_revision = 0;
+    m_event_pool = NULL;
+    m_event_wheel = NULL;
+    m_exit_pool = NULL;
+    m_hasher = NULL;
+    m_idle_check = 0;
+    m_io_threads.clear();
     m_listen = NULL;
-    m_next_character = character_list.begin();
-    m_next_event = event_list.begin();
-    m_next_object = object_list.begin();
-    m_next_socket_client = socket_client_list.begin();
+    m_listeners.clear();
+    m_object_pool = NULL;
     m_port = 0;
+    m_pulse = 0;
+    m_reactor = NULL;
+    m_resolver = NULL;
     m_shutdown = true;
     m_time_boot = chrono::high_resolution_clock::now();
     m_time_current = chrono::high_resolution_clock::now();
@@ -1325,7 +1666,43 @@ Server::Global::Global()
  */
 Server::Global::~Global()
 {
-    m_listen->Delete();
+    // Stopped first as they still reference the listening socket and reactor
+    while ( !m_io_threads.empty() )
+    {
+        m_io_threads.back()->Delete();
+        m_io_threads.pop_back();
+    }
+
+    if ( m_event_wheel != NULL )
+        m_event_wheel->Delete();
+
+    if ( m_hasher != NULL )
+        m_hasher->Delete();
+
+    if ( m_resolver != NULL )
+        m_resolver->Delete();
+
+    while ( !m_listeners.empty() )
+    {
+        m_listeners.back()->Delete();
+        m_listeners.pop_back();
+    }
+
+    if ( m_reactor != NULL )
+        m_reactor->Delete();
+
+    // Released last as the pending events above were still using them
+    if ( m_event_pool != NULL )
+        m_event_pool->Delete();
+
+    if ( m_exit_pool != NULL )
+        m_exit_pool->Delete();
+
+    if ( m_object_pool != NULL )
+        m_object_pool->Delete();
+
+    if ( m_atom_table != NULL )
+        m_atom_table->Delete();
 
     return;
 }
@@ -1337,6 +1714,9 @@ Server::Stats::Stats()
 {
     m_dir_close = 0;
     m_dir_open = 0;
+    m_input_dropped = 0;
+    m_input_limited = 0;
+    m_pulse_overrun = 0;
     m_socket_close = 0;
     m_socket_open = 0;
 
@@ -38,6 +38,15 @@ const bool Socket::Valid() const
 }
 
 /* Query */
+/**
+ * @brief Returns the number of bytes of compressed output the Socket has produced for sending.
+ * @retval uint_t The number of bytes of output after compression.
+ */
+const uint_t Socket::gBytesCompressed() const
+{
+    return m_bytes_compressed;
+}
+
 /**
  * @brief Returns the number of bytes received by the Socket.
  * @retval uint_t The number of bytes received by the Socket.
@@ -56,6 +65,15 @@ const uint_t Socket::gBytesSent() const
     return m_bytes_sent;
 }
 
+/**
+ * @brief Returns the number of bytes of output the Socket has passed through compression.
+ * @retval uint_t The number of bytes of output before compression.
+ */
+const uint_t Socket::gBytesUncompressed() const
+{
+    return m_bytes_uncompressed;
+}
+
 /**
  * @brief Returns the file descriptor associated to the Socket.
  * @retval sint_t The file descriptor associated to the Socket.
@@ -84,6 +102,27 @@ const uint_t Socket::gPort() const
 }
 
 /* Manipulate */
+/**
+ * @brief Increment the total count of compressed bytes produced by the socket.
+ * @param[in] amount A #uint_t value to increase the byte count by.
+ * @retval false Returned if the amount is outside the limits for a #uint_t variable or if the existing counter would overflow.
+ * @retval true Returned if the byte counter was successfully incremented.
+ */
+const bool Socket::aBytesCompressed( const uint_t& amount )
+{
+    UFLAGS_DE( flags );
+
+    if ( amount < uintmin_t || ( ( m_bytes_compressed + amount ) >= uintmax_t ) )
+    {
+        LOGFMT( flags, "Socket::aBytesCompressed()-> called with m_bytes_compressed overflow: %lu + %lu", m_bytes_compressed.load(), amount );
+        return false;
+    }
+
+    m_bytes_compressed += amount;
+
+    return true;
+}
+
 /**
  * @brief Increment the total count of bytes received by the socket.
  * @param[in] amount A #uint_t value to increase the byte count by.
@@ -96,7 +135,7 @@ const bool Socket::aBytesRecvd( const uint_t& amount )
 
     if ( amount < uintmin_t || ( ( m_bytes_recvd + amount ) >= uintmax_t ) )
     {
-        LOGFMT( flags, "Socket::aBytesRecvd()-> called with m_bytes_recvd overflow: %lu + %lu", m_bytes_recvd, amount );
+        LOGFMT( flags, "Socket::aBytesRecvd()-> called with m_bytes_recvd overflow: %lu + %lu", m_bytes_recvd.load(), amount );
         return false;
     }
 
@@ -117,7 +156,7 @@ const bool Socket::aBytesSent( const uint_t& amount )
 
     if ( amount < uintmin_t || ( ( m_bytes_sent + amount ) >= uintmax_t ) )
     {
-        LOGFMT( flags, "Socket::sBytesSent()-> called with m_bytes_sent overflow: %lu + %lu", m_bytes_sent, amount );
+        LOGFMT( flags, "Socket::sBytesSent()-> called with m_bytes_sent overflow: %lu + %lu", m_bytes_sent.load(), amount );
         return false;
     }
 
@@ -126,6 +165,64 @@ const bool Socket::aBytesSent( const uint_t& amount )
     return true;
 }
 
+/**
+ * @brief Increment the total count of bytes passed through compression by the socket.
+ * @param[in] amount A #uint_t value to increase the byte count by.
+ * @retval false Returned if the amount is outside the limits for a #uint_t variable or if the existing counter would overflow.
+ * @retval true Returned if the byte counter was successfully incremented.
+ */
+const bool Socket::aBytesUncompressed( const uint_t& amount )
+{
+    UFLAGS_DE( flags );
+
+    if ( amount < uintmin_t || ( ( m_bytes_uncompressed + amount ) >= uintmax_t ) )
+    {
+        LOGFMT( flags, "Socket::aBytesUncompressed()-> called with m_bytes_uncompressed overflow: %lu + %lu", m_bytes_uncompressed.load(), amount );
+        return false;
+    }
+
+    m_bytes_uncompressed += amount;
+
+    return true;
+}
+
+/**
+ * @brief Sets whether the socket is closed when the process executes a new program image.
+ * @param[in] val True to close the socket on exec, false to leave it open for the new image to inherit.
+ * @retval false Returned if the socket is invalid or the descriptor flags were unable to be changed.
+ * @retval true Returned if the descriptor flags were successfully changed.
+ */
+const bool Socket::sCloseOnExec( const bool& val )
+{
+    UFLAGS_DE( flags );
+    sint_t fd_flags = 0;
+
+    if ( !Valid() )
+    {
+        LOGSTR( flags, "Socket::sCloseOnExec()-> called with invalid socket" );
+        return false;
+    }
+
+    if ( ( fd_flags = ::fcntl( m_descriptor, F_GETFD ) ) < 0 )
+    {
+        LOGERRNO( flags, "Socket::sCloseOnExec()->fcntl()->" );
+        return false;
+    }
+
+    if ( val )
+        fd_flags |= FD_CLOEXEC;
+    else
+        fd_flags &= ~FD_CLOEXEC;
+
+    if ( ::fcntl( m_descriptor, F_SETFD, fd_flags ) < 0 )
+    {
+        LOGERRNO( flags, "Socket::sCloseOnExec()->fcntl()->" );
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief Sets the file descriptor that was opened for the socket.
  * @param[in] descriptor A #sint_t value that corresponds to an open file descriptor.
@@ -195,8 +292,10 @@ const bool Socket::sPort( const uint_t& port )
  */
 Socket::Socket()
 {
+    m_bytes_compressed = 0;
     m_bytes_recvd = 0;
     m_bytes_sent = 0;
+    m_bytes_uncompressed = 0;
     m_descriptor = 0;
     m_hostname.clear();
     m_port = 0;
@@ -22,6 +22,10 @@
  * SocketClient implements client-side / remote-host functions on top of the Socket
  * class. A new SocketClient is created for every connection to the listening
  * SocketServer.
+ *
+ * The socket itself is owned by an IOThread, which calls SocketClient::Recv()
+ * and SocketClient::Flush(). Everything else runs on the game thread, with
+ * input and output passed between the two via SPSCQueue objects.
  */
 #include "h/includes.h"
 #include "h/socketclient.h"
@@ -29,26 +33,95 @@
 #include "h/account.h"
 #include "h/character.h"
 #include "h/command.h"
+#include "h/event.h"
+#include "h/iothread.h"
 #include "h/list.h"
+#include "h/resolver.h"
 #include "h/socketserver.h"
 
 /* Core */
+/**
+ * @brief Checks if a client has been deleted and is waiting on its IOThread to release it.
+ * @retval false Returned if the client is live.
+ * @retval true Returned if the client has been deleted.
+ */
+const bool SocketClient::Closing() const
+{
+    return m_closing;
+}
+
+/**
+ * @brief Compress output for the client. Called from the I/O thread.
+ * @param[in] data The output to compress. May be NULL when only flushing.
+ * @param[in] length The number of bytes within data.
+ * @param[in] mode The zlib flush mode: Z_NO_FLUSH while gathering output, Z_SYNC_FLUSH once output should reach the client, or Z_FINISH to end the stream.
+ * @param[out] output The string to append compressed data to.
+ * @retval false Returned if the client isn't compressing output or zlib reports an error.
+ * @retval true Returned if the data was compressed successfully.
+ */
+const bool SocketClient::Deflate( const char* data, const uint_t& length, const sint_t& mode, string& output )
+{
+    UFLAGS_DE( flags );
+    Bytef buf[CFG_STR_MAX_BUFLEN];
+    uint_t before = output.length();
+    sint_t result = Z_OK;
+
+    if ( m_deflate == NULL )
+    {
+        LOGFMT( flags, "SocketClient::Deflate()-> called on descriptor %ld without a compression stream", gDescriptor() );
+        return false;
+    }
+
+    m_deflate->next_in = reinterpret_cast<Bytef*>( const_cast<char*>( data ) );
+    m_deflate->avail_in = length;
+
+    // A full buffer means zlib may be holding back more
+    do
+    {
+        m_deflate->next_out = buf;
+        m_deflate->avail_out = sizeof( buf );
+
+        if ( ( result = ::deflate( m_deflate, mode ) ) == Z_STREAM_ERROR )
+        {
+            LOGFMT( flags, "SocketClient::Deflate()->deflate()-> descriptor %ld returned error: %ld", gDescriptor(), result );
+            return false;
+        }
+
+        output.append( reinterpret_cast<char*>( buf ), sizeof( buf ) - m_deflate->avail_out );
+    } while ( m_deflate->avail_out == 0 );
+
+    if ( !g_global->m_listen->aBytesUncompressed( length ) || !aBytesUncompressed( length ) )
+        LOGFMT( flags, "SocketClient::Deflate()->Socket::aBytesUncompressed()-> descriptor %ld value %lu returned false", gDescriptor(), length );
+
+    if ( !g_global->m_listen->aBytesCompressed( output.length() - before ) || !aBytesCompressed( output.length() - before ) )
+        LOGFMT( flags, "SocketClient::Deflate()->Socket::aBytesCompressed()-> descriptor %ld value %lu returned false", gDescriptor(), output.length() - before );
+
+    return true;
+}
+
 /**
  * @brief Unload a client's socket from memory that was previously loaded via SocketClient::New().
+ * Once the client has been handed to an IOThread it is only released after the I/O thread reports #SOC_IO_CLOSED.
  * @retval void
  */
 const void SocketClient::Delete()
 {
     UFLAGS_DE( flags );
 
-    if ( !Valid() )
+    if ( !Valid() || m_closing )
         return;
 
-    if ( find( socket_client_list.begin(), socket_client_list.end(), this ) != socket_client_list.end() )
-        g_global->m_next_socket_client = socket_client_list.erase( find( socket_client_list.begin(), socket_client_list.end(), this ) );
+    Event::Cancel( &m_events );
+
+    socket_client_list.Remove( m_list_handle );
+
+    // Ending the compression stream lets the client tell a close from a corrupt stream
+    if ( m_terminfo->gNegotiated( SOC_TELOPT_COMPRESS2 ) )
+        Telopt::Negotiate( this, SOC_TELOPT_COMPRESS2, false );
 
     // Force anything out of the buffer
     Send();
+    sOutputPending( false );
 
     if ( !g_stats->sSocketClose( g_stats->gSocketClose() + 1 ) )
         LOGFMT( flags, "SocketClient::Disconnect()->Server::Stats::sSocketClose()-> value %lu returned false", g_stats->gSocketClose() + 1 );
@@ -56,6 +129,16 @@ const void SocketClient::Delete()
     if ( m_account != NULL )
         m_account->Delete();
 
+    m_account = NULL;
+    m_closing = true;
+
+    // The I/O thread may still be writing to the socket
+    if ( m_io_thread != NULL )
+    {
+        m_io_thread->Post( this, SOC_IO_CLOSE );
+        return;
+    }
+
     delete this;
 
     return;
@@ -71,21 +154,18 @@ const void SocketClient::Delete()
 const bool SocketClient::New( const sint_t& descriptor, const bool& reboot )
 {
     UFLAGS_DE( flags );
-    sint_t error = 0;
+    sint_t error = 0, nodelay = 1;
     sockaddr_storage sin;
     socklen_t size = static_cast<socklen_t>( sizeof( sin ) );
     char hostname[CFG_STR_MAX_BUFLEN], service[CFG_STR_MAX_BUFLEN];
 
     sDescriptor( descriptor );
 
+    // Listed first; the greeting below is queued for output by the handle
+    m_list_handle = socket_client_list.Add( this );
+
     if ( !reboot )
     {
-        if ( ::fcntl( gDescriptor(), F_SETFL, O_NONBLOCK ) < 0 )
-        {
-            LOGERRNO( flags, "SocketClient::New()->fcntl()->" );
-            return false;
-        }
-
         if ( ::getpeername( gDescriptor(), reinterpret_cast<sockaddr*>( &sin ), &size ) < 0 )
         {
             LOGERRNO( flags, "SocketClient::New()->getpeername()->" );
@@ -98,7 +178,7 @@ const bool SocketClient::New( const sint_t& descriptor, const bool& reboot )
         }
         else
         {
-            if ( ( error = ::getnameinfo( reinterpret_cast<sockaddr*>( &sin ), size, hostname, sizeof( hostname ), service, sizeof( service ), NI_NUMERICSERV) ) != 0 )
+            if ( ( error = ::getnameinfo( reinterpret_cast<sockaddr*>( &sin ), size, hostname, sizeof( hostname ), service, sizeof( service ), NI_NUMERICHOST | NI_NUMERICSERV ) ) != 0 )
             {
                 LOGFMT( flags, "SocketClient::New()->getnameinfo()-> returned errno %d:%s", error, gai_strerror( error ) );
                 return false;
@@ -117,6 +197,9 @@ const bool SocketClient::New( const sint_t& descriptor, const bool& reboot )
             }
 
             LOGFMT( 0, "SocketClient::New()-> %s:%lu (%lu)", CSTR( gHostname() ), gPort(), gDescriptor() );
+
+            // The numeric address stands in until the lookup completes
+            ResolveHostname();
         }
 
         // negotiate telopts, send login message
@@ -134,21 +217,211 @@ const bool SocketClient::New( const sint_t& descriptor, const bool& reboot )
 
         Handler::LoginHandler( this );
     }
+    // Close-on-exec was cleared so the socket would survive the reboot
+    else if ( !sCloseOnExec( true ) )
+    {
+        LOGSTR( flags, "SocketClient::New()->SocketClient::sCloseOnExec()-> returned false" );
+        return false;
+    }
+
+    // Output is already gathered into one write per pulse, so holding back a trailing prompt gains nothing
+    if ( ::setsockopt( gDescriptor(), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>( &nodelay ), sizeof( nodelay ) ) < 0 )
+        LOGERRNO( flags, "SocketClient::New()->setsockopt()->" );
+
+    if ( g_global->m_io_threads.empty() )
+    {
+        LOGSTR( flags, "SocketClient::New()-> called with no IOThread to own the socket" );
+        return false;
+    }
 
     g_stats->sSocketOpen( g_stats->gSocketOpen() + 1 );
-    socket_client_list.push_back( this );
+
+    // Spread clients across the I/O threads; the descriptor is as good a spread as any
+    m_io_thread = g_global->m_io_threads[gDescriptor() % g_global->m_io_threads.size()];
+    m_io_thread->Post( this, SOC_IO_ADD );
 
     return true;
 }
 
 /**
- * @brief Tests if there are any commands in the queue to be processed.
- * @retval false Returned if the command queue is empty.
- * @retval true Returned if the command queue is not empty.
+ * @brief Write as much queued output to the client as the socket will currently accept. Called from the I/O thread.
+ * Output is held as a list of segments so partial writes never copy or reallocate what remains, and as many segments
+ * as possible are handed to the kernel in a single call.
+ * @retval false Returned if there was an error sending data to the client or it has exceeded #CFG_SOC_MAX_OUTPUT.
+ * @retval true Returned if the data was sent, or was retained because the socket is unable to accept more yet.
+ */
+const bool SocketClient::Flush()
+{
+    UFLAGS_DE( flags );
+    ssize_t amount = 0;
+    vector<Segment> output;
+    string compressed;
+    static msghdr msg_zero;
+    msghdr msg = msg_zero;
+    iovec iov[CFG_SOC_MAX_IOVEC];
+    ITER( deque, Segment, wi );
+    ITER( vector, Segment, oi );
+    uint_t count = 0, remain = 0;
+
+    if ( !Valid() )
+    {
+        LOGFMT( flags, "SocketClient::Flush()->SocketClient::Valid()-> descriptor %ld returned false", gDescriptor() );
+        return false;
+    }
+
+    while ( m_output_queue.Pop( output ) )
+    {
+        for ( oi = output.begin(); oi != output.end(); oi++ )
+        {
+            // The markers for compression are recognized by identity; ending the stream flushes whatever it still holds
+            if ( *oi == Telopt::opt_compress_end )
+            {
+                if ( !sCompress( false, compressed ) )
+                    return false;
+
+                continue;
+            }
+
+            if ( ( *oi )->empty() )
+                continue;
+
+            if ( m_deflate != NULL )
+            {
+                if ( !Deflate( ( *oi )->data(), ( *oi )->length(), Z_NO_FLUSH, compressed ) )
+                    return false;
+
+                continue;
+            }
+
+            // Output compressed before the stream ended goes out ahead of this segment
+            if ( !compressed.empty() )
+            {
+                m_write_size += compressed.length();
+                m_write_buffer.push_back( make_shared<const string>( compressed ) );
+                compressed.clear();
+            }
+
+            m_write_size += ( *oi )->length();
+            m_write_buffer.push_back( *oi );
+
+            // Everything after the start marker is compressed
+            if ( *oi == Telopt::opt_compress_start && !sCompress( true, compressed ) )
+                return false;
+        }
+    }
+
+    // Compressed output is flushed once per pass so the client is able to decode all of it right away
+    if ( m_deflate != NULL && !Deflate( NULL, 0, Z_SYNC_FLUSH, compressed ) )
+        return false;
+
+    if ( !compressed.empty() )
+    {
+        m_write_size += compressed.length();
+        m_write_buffer.push_back( make_shared<const string>( compressed ) );
+    }
+
+    // The client has stopped reading entirely; cut it off rather than buffer without bound
+    if ( m_write_size > CFG_SOC_MAX_OUTPUT )
+    {
+        LOGFMT( flags, "SocketClient::Flush()-> disconnecting descriptor %ld with %lu bytes of unsent output", gDescriptor(), m_write_size );
+        return false;
+    }
+
+    if ( !m_throttled && m_write_size >= CFG_SOC_OUTPUT_HIGH_WATER )
+    {
+        LOGFMT( 0, "SocketClient::Flush()-> throttling descriptor %ld with %lu bytes of unsent output", gDescriptor(), m_write_size );
+        m_throttled = true;
+    }
+
+    // Write until drained or the socket is full; the reactor will report when the socket drains
+    while ( !m_write_buffer.empty() && m_writable )
+    {
+        for ( count = 0, wi = m_write_buffer.begin(); wi != m_write_buffer.end() && count < CFG_SOC_MAX_IOVEC; wi++, count++ )
+        {
+            iov[count].iov_base = const_cast<char*>( ( *wi )->data() );
+            iov[count].iov_len = ( *wi )->length();
+        }
+
+        // The front segment may have been partially written already
+        iov[0].iov_base = reinterpret_cast<char*>( iov[0].iov_base ) + m_write_offset;
+        iov[0].iov_len -= m_write_offset;
+
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        // Corks the socket while more of the buffer remains than fits in one call, so the kernel fills whole packets
+        if ( ( amount = ::sendmsg( gDescriptor(), &msg, MSG_NOSIGNAL | ( wi != m_write_buffer.end() ? MSG_MORE : 0 ) ) ) < 1 )
+        {
+            if ( amount == 0 )
+            {
+                LOGFMT( flags, "SocketClient::Flush()->sendmsg()-> broken pipe encountered on send to descriptor %ld", gDescriptor() );
+                return false;
+            }
+            else if ( errno == EINTR )
+                continue;
+            else if ( errno == EAGAIN || errno == EWOULDBLOCK )
+            {
+                // Keep the remainder until the reactor reports the socket as writable again
+                m_writable = false;
+                break;
+            }
+            else
+            {
+                LOGERRNO( flags, "SocketClient::Flush()->sendmsg()->" );
+                return false;
+            }
+        }
+
+        if ( !g_global->m_listen->aBytesSent( amount ) )
+        {
+            LOGFMT( flags, "SocketClient::Flush()->SocketServer::aBytesSent()-> value %lu returned false", g_global->m_listen->gBytesSent() + amount );
+            return false;
+        }
+
+        if ( !aBytesSent( amount ) )
+        {
+            LOGFMT( flags, "SocketClient::Flush()->SocketClient::aBytesSent()-> value %lu returned false", gBytesSent() + amount );
+            return false;
+        }
+
+        // Release every segment that was completely written and remember how far into the next one we got
+        m_write_size -= amount;
+        m_write_offset += amount;
+
+        while ( !m_write_buffer.empty() && m_write_offset >= ( remain = m_write_buffer.front()->length() ) )
+        {
+            m_write_offset -= remain;
+            m_write_buffer.pop_front();
+        }
+    }
+
+    if ( m_throttled && m_write_size <= CFG_SOC_OUTPUT_LOW_WATER )
+    {
+        LOGFMT( 0, "SocketClient::Flush()-> resuming descriptor %ld with %lu bytes of unsent output", gDescriptor(), m_write_size );
+        m_throttled = false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Tests if there are any commands in the queue ready to be processed. Up to #CFG_GAM_CMD_BURST are run per pulse, and none while throttled or quitting.
+ * @retval false Returned if the command queue is empty, the client's burst for this pulse has been used, or the client is throttled or quitting.
+ * @retval true Returned if the command queue is not empty and the client may run another command this pulse.
  */
 const bool SocketClient::PendingCommand() const
 {
-    return !m_command_queue.empty();
+    return !m_command_queue.empty() && gCommandsRun() < CFG_GAM_CMD_BURST && !m_throttled && !m_quitting;
+}
+
+/**
+ * @brief Tests if a preempt command is waiting at the front of the queue. These aren't held to #CFG_GAM_CMD_BURST.
+ * @retval false Returned if the front of the queue isn't a preempt command, or the client is throttled or quitting.
+ * @retval true Returned if a preempt command is ready to be processed.
+ */
+const bool SocketClient::PendingPreempt() const
+{
+    return m_command_preempt > 0 && !m_throttled && !m_quitting;
 }
 
 /**
@@ -158,7 +431,7 @@ const bool SocketClient::PendingCommand() const
  */
 const bool SocketClient::PendingOutput() const
 {
-    return !m_output.empty();
+    return !m_output.empty() || !m_output_chain.empty();
 }
 
 /**
@@ -169,8 +442,7 @@ const bool SocketClient::PendingOutput() const
 const bool SocketClient::ProcessCommand()
 {
     UFLAGS_DE( flags );
-    pair<string,string> cmd;
-    Command* command = NULL;
+    SocketClient::QueuedCommand cmd;
     uint_t security = ACT_SECURITY_NONE;
 
     if ( !Valid() )
@@ -189,18 +461,28 @@ const bool SocketClient::ProcessCommand()
     cmd = m_command_queue.front();
     m_command_queue.pop_front();
 
+    // A Command loaded or unloaded since this was queued may have changed what it resolves to
+    if ( cmd.m_revision != g_global->m_command_revision )
+        cmd.m_command = Handler::FindCommand( cmd.m_cmd );
+
+    if ( m_command_preempt > 0 )
+        m_command_preempt--;
+
+    m_commands_run = gCommandsRun() + 1;
+    m_last_command = g_global->m_pulse;
+
     // Redirect if not fully logged in yet
     if ( m_state < SOC_STATE_PLAYING )
-        Handler::LoginHandler( this, cmd.first, cmd.second );
+        Handler::LoginHandler( this, cmd.m_cmd, cmd.m_args );
     else
     {
         // Raw run if no Character exists to interpret
         if ( m_account == NULL || m_account->gCharacter() == NULL )
         {
-            if ( ( command = Handler::FindCommand( cmd.first ) ) != NULL )
+            if ( cmd.m_command != NULL )
             {
-                if ( command->Authorized( security ) )
-                    command->Run( this, cmd.first, cmd.second );
+                if ( cmd.m_command->Authorized( security ) )
+                    cmd.m_command->Run( this, cmd.m_cmd, cmd.m_args );
                 else
                     Send( CFG_STR_CMD_INVALID );
             }
@@ -208,23 +490,22 @@ const bool SocketClient::ProcessCommand()
                 Send( CFG_STR_CMD_INVALID );
         }
         else
-            m_account->gCharacter()->Interpret( security, cmd.first, cmd.second );
+            m_account->gCharacter()->Interpret( security, cmd.m_cmd, cmd.m_args, cmd.m_command );
     }
 
     return true;
 }
 
 /**
- * @brief Process data from the client's receive buffer and split it into commands to queue as necessary.
+ * @brief Process input handed over by the I/O thread, queueing commands and answering telnet negotiations as necessary.
  * @retval false Returned if the socket is invalid or if a critical fault occurs when adding the command to the queue.
  * @retval true Returned if there is no input to process or input was processed successfully.
  */
 const bool SocketClient::ProcessInput()
 {
     UFLAGS_DE( flags );
-    vector<string> commands;
-    string command;
-    ITER( vector, string, vi );
+    pair<uint_t,string> input;
+    bool received = false;
 
     if ( !Valid() )
     {
@@ -232,22 +513,74 @@ const bool SocketClient::ProcessInput()
         return false;
     }
 
-    // Nothing new to process; move along
-    if ( m_input.empty() )
-        return true;
+    // Top up the command bucket for every pulse since it was last refilled
+    if ( m_command_refill != g_global->m_pulse )
+    {
+        m_command_tokens = min<uint_t>( m_command_tokens + ( g_global->m_pulse - m_command_refill ) * CFG_SOC_INPUT_COMMAND_RATE, CFG_SOC_INPUT_COMMAND_BURST * CFG_GAM_PULSE_RATE );
+        m_command_refill = g_global->m_pulse;
+    }
 
-    commands = Utils::StrNewlines( m_input );
-    for ( vi = commands.begin(); vi != commands.end(); vi++ )
+    while ( m_input_queue.Pop( input ) )
     {
-        command = *vi;
-        if ( !QueueCommand( command ) )
+        received = true;
+
+        switch ( input.first )
         {
-            LOGFMT( flags, "SocketClient::ProcessInput()->SocketClient::QueueCommand()-> command %s returned false", CSTR( command ) );
-            return false;
+            case SOC_INPUT_LINE:
+                // Flooding is dealt with before the line costs a command lookup or any memory
+                if ( m_command_tokens < CFG_GAM_PULSE_RATE || m_command_queue.size() >= CFG_SOC_MAX_COMMAND_QUEUE )
+                {
+                    if ( !g_stats->sInputDropped( g_stats->gInputDropped() + 1 ) )
+                        LOGFMT( flags, "SocketClient::ProcessInput()->Server::Stats::sInputDropped()-> value %lu returned false", g_stats->gInputDropped() + 1 );
+
+                    switch ( CFG_SOC_INPUT_OVERFLOW )
+                    {
+                        case SOC_OVERFLOW_DISCONNECT:
+                            LOGFMT( flags, "SocketClient::ProcessInput()-> disconnecting descriptor %ld for flooding input", gDescriptor() );
+                            return false;
+
+                        case SOC_OVERFLOW_WARN:
+                            if ( !m_input_overflow )
+                                Send( CFG_STR_INPUT_OVERFLOW );
+                        break;
+
+                        default:
+                        break;
+                    }
+
+                    m_input_overflow = true;
+                    break;
+                }
+
+                m_command_tokens -= CFG_GAM_PULSE_RATE;
+                m_input_overflow = false;
+
+                if ( !QueueCommand( input.second ) )
+                {
+                    LOGFMT( flags, "SocketClient::ProcessInput()->SocketClient::QueueCommand()-> command %s returned false", CSTR( input.second ) );
+                    return false;
+                }
+            break;
+
+            case SOC_INPUT_TELOPT:
+                Telopt::Handshake( this, input.second[0], input.second[1] );
+            break;
+
+            default:
+                LOGFMT( flags, "SocketClient::ProcessInput()-> called with invalid input type: %lu", input.first );
+            break;
         }
     }
 
-    m_input.clear();
+    // Nothing new to process; move along
+    if ( !received )
+        return true;
+
+    if ( !sIdle( 0 ) )
+    {
+        LOGSTR( flags, "SocketClient::ProcessInput()->SocketClient::sIdle()-> value 0 returned false" );
+        return false;
+    }
 
     return true;
 }
@@ -260,8 +593,7 @@ const bool SocketClient::ProcessInput()
 const bool SocketClient::QueueCommand( const string& command )
 {
     UFLAGS_DE( flags );
-    string args, cmd;
-    Command* search = NULL;
+    SocketClient::QueuedCommand queued;
 
     if ( !Valid() )
     {
@@ -269,19 +601,19 @@ const bool SocketClient::QueueCommand( const string& command )
         return false;
     }
 
-    args = command;
-    cmd = Utils::Argument( args );
+    queued.m_args = command;
+    queued.m_cmd = Utils::Argument( queued.m_args );
+    queued.m_command = Handler::FindCommand( queued.m_cmd );
+    queued.m_revision = g_global->m_command_revision;
 
-    // Check to see if the command can preempt and go to the front of the queue
-    if ( ( search = Handler::FindCommand( cmd ) ) != NULL )
+    // Check to see if the command can preempt and go to the front of the queue; behind any preempt commands already waiting, so that they still run in the order received
+    if ( queued.m_command != NULL && queued.m_command->gPreempt() )
     {
-        if ( search->gPreempt() )
-            m_command_queue.push_front( pair<string,string>( cmd, args ) );
-        else
-            m_command_queue.push_back( pair<string,string>( cmd, args ) );
+        m_command_queue.insert( m_command_queue.begin() + m_command_preempt, queued );
+        m_command_preempt++;
     }
     else
-        m_command_queue.push_back( pair<string,string>( cmd, args ) );
+        m_command_queue.push_back( queued );
 
     return true;
 }
@@ -309,6 +641,7 @@ const void SocketClient::Quit()
     LOGFMT( flags, "SocketClient::Quit()-> %s:%lu (%lu)", CSTR( gHostname() ), gPort(), gDescriptor() );
 
     m_quitting = true;
+    sOutputPending( true );
 
     return;
 }
@@ -324,7 +657,7 @@ const bool SocketClient::Quitting() const
 }
 
 /**
- * @brief Receive data from the client and append it to a receive buffer.
+ * @brief Receive data from the client, strip telnet sequences and queue any complete lines for the game thread. Called from the I/O thread.
  * @retval false Returned if there was an error while receiving data.
  * @retval true Returned if there is no data to receive or data was received successfully.
  */
@@ -332,7 +665,10 @@ const bool SocketClient::Recv()
 {
     UFLAGS_DE( flags );
     ssize_t amount = 0;
-    char buf[CFG_STR_MAX_BUFLEN] = {'\0'};
+    char buf[CFG_STR_MAX_BUFLEN];
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    uint_t refill = 0;
+    string::size_type start = 0, end = 0, next = 0;
 
     if ( !Valid() )
     {
@@ -340,58 +676,109 @@ const bool SocketClient::Recv()
         return false;
     }
 
-    if ( ( m_input.length() + CFG_STR_MAX_BUFLEN ) >= m_input.max_size() )
+    // Top up the byte bucket for the time since it was last refilled
+    if ( ( refill = chrono::duration_cast<chrono::microseconds>( now - m_input_refill ).count() * CFG_SOC_INPUT_BYTE_RATE / USLEEP_MAX ) > 0 )
     {
-        LOGFMT( flags, "SocketClient::Recv()-> called with m_input overflow: %lu + %lu", m_input.length(), CFG_STR_MAX_BUFLEN );
-        return false;
+        m_input_tokens = min<uint_t>( m_input_tokens + refill, CFG_SOC_INPUT_BYTE_BURST );
+        m_input_refill = now;
     }
 
-    if ( ( amount = ::recv( gDescriptor(), buf, CFG_STR_MAX_BUFLEN - 1, 0 ) ) < 1 )
+    m_input_limited = false;
+
+    // Readiness is edge-triggered and only reported once, so drain the socket until it would block
+    for ( ;; )
     {
-        if ( amount == 0 )
+        // Whatever is left stays in the kernel, pushing back on the client, until the IOThread retries once the bucket refills
+        if ( m_input_tokens == 0 )
         {
-            LOGFMT( flags, "SocketClient::Recv()->recv()-> broken pipe encountered on recv from: %s", CSTR( gHostname() ) );
+            m_input_limited = true;
+            break;
+        }
+
+        if ( ( m_input.length() + CFG_STR_MAX_BUFLEN ) >= m_input.max_size() )
+        {
+            LOGFMT( flags, "SocketClient::Recv()-> called with m_input overflow: %lu + %lu", m_input.length(), CFG_STR_MAX_BUFLEN );
             return false;
         }
-        else if ( errno != EAGAIN && errno != EWOULDBLOCK )
+
+        if ( ( amount = ::recv( gDescriptor(), buf, min<uint_t>( CFG_STR_MAX_BUFLEN, m_input_tokens ), 0 ) ) < 1 )
         {
-            LOGERRNO( flags, "SocketClient::Recv()->recv()->" );
+            if ( amount == 0 )
+            {
+                LOGFMT( flags, "SocketClient::Recv()->recv()-> broken pipe encountered on recv from descriptor %ld", gDescriptor() );
+                return false;
+            }
+            else if ( errno == EINTR )
+                continue;
+            else if ( errno != EAGAIN && errno != EWOULDBLOCK )
+            {
+                LOGERRNO( flags, "SocketClient::Recv()->recv()->" );
+                return false;
+            }
+
+            break;
+        }
+
+        m_input_tokens -= amount;
+
+        if ( !g_global->m_listen->aBytesRecvd( amount ) )
+        {
+            LOGFMT( flags, "SocketClient::Recv()->SocketServer::aBytesRecvd()-> value %lu returned false", g_global->m_listen->gBytesRecvd() + amount );
             return false;
         }
-    }
 
-    if ( !g_global->m_listen->aBytesRecvd( amount ) )
-    {
-        LOGFMT( flags, "SocketClient::Recv()->SocketServer::aBytesRecvd()-> value %lu returned false", g_global->m_listen->gBytesRecvd() + amount );
-        return false;
+        if ( !aBytesRecvd( amount ) )
+        {
+            LOGFMT( flags, "SocketClient::Recv()->SocketClient::aBytesRecvd()-> value %lu returned false", gBytesRecvd() + amount );
+            return false;
+        }
+
+        // Plain data is appended to m_input as it is parsed; negotiations are queued for the game thread directly
+        Telopt::ProcessInput( this, buf, amount, m_input );
     }
 
-    if ( !aBytesRecvd( amount ) )
+    // Nothing new to process; move along
+    if ( m_input.empty() )
+        return true;
+
+    // Lines may end with LF, CRLF, CR NUL, or a bare CR; whatever follows the last of them waits for the next read
+    for ( start = 0; ( end = m_input.find_first_of( "\r\n", start ) ) != string::npos; start = next )
     {
-        LOGFMT( flags, "SocketClient::Recv()->SocketClient::aBytesRecvd()-> value %lu returned false", gBytesRecvd() + amount );
-        return false;
+        // The LF or NUL that completes a CR may still be in flight
+        if ( m_input[end] == '\r' && end + 1 == m_input.length() )
+            break;
+
+        next = end + 1;
+
+        if ( m_input[end] == '\r' && ( m_input[next] == '\n' || m_input[next] == '\0' ) )
+            next++;
+
+        // Blank lines are ignored
+        if ( end > start )
+            aInput( SOC_INPUT_LINE, m_input.data() + start, end - start );
     }
 
-    if ( !sIdle( 0 ) )
+    // A client that never ends its line is cut off into pieces rather than buffered without bound
+    if ( m_input.length() - start >= CFG_STR_MAX_BUFLEN )
     {
-        LOGSTR( flags, "SocketClient::Recv()->SocketClient::sIdle()-> value 0 returned false" );
-        return false;
+        aInput( SOC_INPUT_LINE, m_input.data() + start, m_input.length() - start );
+        start = m_input.length();
     }
 
-    m_input.append( Telopt::ProcessInput( this, buf ) );
+    m_input.erase( 0, start );
 
     return true;
 }
 
 /**
- * @brief A wrapper to SocketClient::tResolveHostname(). Necessary for threading a member function.
+ * @brief Look up the hostname of the client without blocking. Unless the address is cached, the hostname is replaced
+ * once the Resolver has an answer.
  * @retval void
  */
 const void SocketClient::ResolveHostname()
 {
     UFLAGS_DE( flags );
-    pthread_t res_thread;
-    pthread_attr_t res_attr;
+    string hostname;
 
     if ( !Valid() )
     {
@@ -399,27 +786,12 @@ const void SocketClient::ResolveHostname()
         return;
     }
 
-    if ( ::pthread_attr_init( &res_attr ) != 0 )
-    {
-        LOGERRNO( flags, "SocketClient::ResolveHostname()->pthread_attr_init()->" );
-        return;
-    }
-
-    if ( ::pthread_attr_setdetachstate( &res_attr, PTHREAD_CREATE_DETACHED ) != 0 )
-    {
-        LOGERRNO( flags, "SocketClient::ResolveHostname()->pthread_attr_setdetachstate()->" );
+    if ( !g_global->m_resolver->Lookup( m_list_handle, gHostname(), hostname ) || hostname.empty() )
         return;
-    }
 
-    if ( ::pthread_create( &res_thread, &res_attr, &SocketClient::tResolveHostname, this ) != 0 )
+    if ( !sHostname( hostname ) )
     {
-        LOGERRNO( flags, "SocketClient::ResolveHostname()->pthread_create()->" );
-        return;
-    }
-
-    if ( ::pthread_attr_destroy( &res_attr ) != 0 )
-    {
-        LOGERRNO( flags, "SocketClient::ResolveHostname()->pthread_attr_destroy()->" );
+        LOGFMT( flags, "SocketClient::ResolveHostname()->SocketClient::sHostname()-> hostname %s returned false", CSTR( hostname ) );
         return;
     }
 
@@ -434,7 +806,6 @@ const void SocketClient::ResolveHostname()
 const bool SocketClient::Send()
 {
     UFLAGS_DE( flags );
-    ssize_t amount = 0;
 
     if ( !Valid() )
     {
@@ -456,40 +827,24 @@ const bool SocketClient::Send()
             return false;
         }
 
-        Send( gAccount()->gCharacter()->gPrompt() );
-    }
-
-    // Nothing new to process; move along
-    if ( m_output.empty() )
-        return true;
-
-    if ( ( amount = ::send( gDescriptor(), CSTR( m_output ), m_output.length(), 0 ) ) < 1 )
-    {
-        if ( amount == 0 )
-        {
-            LOGFMT( flags, "SocketClient::Send()->send()-> broken pipe encountered on send to: %s", CSTR( gHostname() ) );
-            return false;
-        }
-        else if ( errno != EAGAIN && errno != EWOULDBLOCK )
-        {
-            LOGERRNO( flags, "SocketClient::Send()->send()->" );
-            return false;
-        }
+        // Appended directly so the prompt itself doesn't queue the client for another flush
+        m_output.append( Telopt::ProcessOutput( gAccount()->gCharacter()->gPrompt() ) );
     }
 
-    if ( !g_global->m_listen->aBytesSent( amount ) )
+    if ( !m_output.empty() )
     {
-        LOGFMT( flags, "SocketClient::Send()->SocketServer::aBytesSent()-> value %lu returned false", g_global->m_listen->gBytesSent() + amount );
-        return false;
+        m_output_chain.push_back( make_shared<const string>( m_output ) );
+        m_output.clear();
     }
 
-    if ( !aBytesSent( amount ) )
-    {
-        LOGFMT( flags, "SocketClient::Send()->SocketClient::aBytesSent()-> value %lu returned false", gBytesSent() + amount );
-        return false;
-    }
+    // Not yet owned by an I/O thread; hold on to it until it is
+    if ( m_output_chain.empty() || m_io_thread == NULL )
+        return true;
 
-    m_output.clear();
+    // Everything buffered this pulse is handed over in a single piece
+    m_output_queue.Push( m_output_chain );
+    m_output_chain.clear();
+    m_io_thread->Post( this, SOC_IO_FLUSH );
 
     return true;
 }
@@ -510,7 +865,41 @@ const bool SocketClient::Send( const string& msg )
         return false;
     }
 
-    m_output.append( Telopt::ProcessOutput( this, msg ) );
+    m_output.append( Telopt::ProcessOutput( msg ) );
+    sOutputPending( true );
+
+    return true;
+}
+
+/**
+ * @brief Buffer a shared segment to be sent to the client. The segment is queued by reference rather than copied.
+ * @param[in] msg The segment to be sent, as already processed by Telopt::ProcessOutput().
+ * @retval false Returned if the socket is invalid.
+ * @retval true Returned if the segment was buffered.
+ */
+const bool SocketClient::Send( const Segment& msg )
+{
+    UFLAGS_DE( flags );
+
+    if ( !Valid() )
+    {
+        LOGFMT( flags, "SocketClient::Send()->SocketClient::Valid()-> descriptor %ld returned false", gDescriptor() );
+        return false;
+    }
+
+    // Ending compression is marked with an empty segment, which has to reach the I/O thread
+    if ( !msg || ( msg->empty() && msg != Telopt::opt_compress_end ) )
+        return true;
+
+    // Output buffered privately so far must go out ahead of the shared segment
+    if ( !m_output.empty() )
+    {
+        m_output_chain.push_back( make_shared<const string>( m_output ) );
+        m_output.clear();
+    }
+
+    m_output_chain.push_back( msg );
+    sOutputPending( true );
 
     return true;
 }
@@ -573,13 +962,70 @@ Account* SocketClient::gAccount() const
     return m_account;
 }
 
+/**
+ * @brief Returns the number of commands from the queue run for the client during the current pulse.
+ * @retval uint_t The number of commands run this pulse.
+ */
+const uint_t SocketClient::gCommandsRun() const
+{
+    return m_last_command == g_global->m_pulse ? m_commands_run : 0;
+}
+
+/**
+ * @brief Returns if output to the client is currently being compressed. Called from the I/O thread.
+ * @retval false Returned if output is sent uncompressed.
+ * @retval true Returned if output is passed through an MCCP2 compression stream.
+ */
+const bool SocketClient::gCompress() const
+{
+    return m_deflate != NULL;
+}
+
+/**
+ * @brief Returns the pending events initiated by the client. Used by Event to add and remove itself.
+ * @retval list<Event*>* A pointer to the list of pending events.
+ */
+list<Event*>* SocketClient::gEvents()
+{
+    return &m_events;
+}
+
+/**
+ * @brief Returns if the connection has failed or been closed. Called from the I/O thread.
+ * @retval false Returned if the connection is still usable.
+ * @retval true Returned if the connection has failed or been closed.
+ */
+const bool SocketClient::gHangup() const
+{
+    return m_hangup;
+}
+
 /**
  * @brief Returns the amount of time the client has been idle.
- * @retval uint_t The number of seconds the client has been idle.
+ * @retval uint_t The number of pulses since data was last received from the client.
  */
 const uint_t SocketClient::gIdle() const
 {
-    return m_idle;
+    return static_cast<sint_t>( g_global->m_pulse ) - m_last_input;
+}
+
+/**
+ * @brief Returns if the last read stopped short for exceeding #CFG_SOC_INPUT_BYTE_RATE. Called from the I/O thread.
+ * @retval false Returned if the socket was read until it would block.
+ * @retval true Returned if data may remain unread until the byte bucket refills.
+ */
+const bool SocketClient::gInputLimited() const
+{
+    return m_input_limited;
+}
+
+/**
+ * @brief Returns a handle to the client which, unlike a pointer, can be safely tested after the client has been deleted.
+ * @retval SlotHandle A handle which resolves through socket_client_list while the client exists.
+ */
+const SlotHandle SocketClient::gListHandle() const
+{
+    return m_list_handle;
 }
 
 /**
@@ -600,6 +1046,16 @@ const string SocketClient::gLogin( const uint_t& key ) const
     return m_login[key];
 }
 
+/**
+ * @brief Returns whether the client is queued within socket_client_output_list to be visited on the next pulse.
+ * @retval false Returned if the client is not queued.
+ * @retval true Returned if the client is queued.
+ */
+const bool SocketClient::gOutputPending() const
+{
+    return m_output_pending;
+}
+
 /**
  * @brief Returns the connection state of the client from #SOC_STATE.
  * @retval uint_t The current connection state of the client.
@@ -609,6 +1065,24 @@ const uint_t SocketClient::gState() const
     return m_state;
 }
 
+/**
+ * @brief Returns the telnet command awaiting its option byte. Called from the I/O thread.
+ * @retval char The DO, DONT, WILL, or WONT received before the end of the last read.
+ */
+const char SocketClient::gTelnetCommand() const
+{
+    return m_telnet_cmd;
+}
+
+/**
+ * @brief Returns the state Telopt::ProcessInput() left the telnet parser in after the last read. Called from the I/O thread.
+ * @retval uint_t The current telnet parser state from #SOC_TELNET.
+ */
+const uint_t SocketClient::gTelnetState() const
+{
+    return m_telnet_state;
+}
+
 /**
  * @brief Returns a pointer to the terminal information of the SocketClient.
  * @retval SocketClient::TermInfo* A pointer to the terminal information of the SocketClient.
@@ -618,6 +1092,16 @@ SocketClient::TermInfo* SocketClient::gTermInfo() const
     return m_terminfo;
 }
 
+/**
+ * @brief Returns if the client is being throttled because too much of its output is unsent.
+ * @retval false Returned if input is being read and run as normal.
+ * @retval true Returned if input is being left unread and unrun until output drains to #CFG_SOC_OUTPUT_LOW_WATER.
+ */
+const bool SocketClient::gThrottled() const
+{
+    return m_throttled;
+}
+
 /* Manipulate */
 /**
  * @brief Sets if a telopt has been previously negotiated.
@@ -663,6 +1147,33 @@ const bool SocketClient::TermInfo::sTelopt( const uint_t& opt, const bool& val )
     return true;
 }
 
+/**
+ * @brief Queue input for the game thread to process via SocketClient::ProcessInput(). Called from the I/O thread.
+ * @param[in] type The type of input from #SOC_INPUT.
+ * @param[in] input A line of input, or a telnet command followed by its option.
+ * @retval void
+ */
+const void SocketClient::aInput( const uint_t& type, const string& input )
+{
+    m_input_queue.Push( pair<uint_t,string>( type, input ) );
+
+    return;
+}
+
+/**
+ * @brief Queue input for the game thread to process via SocketClient::ProcessInput(), copying it only once. Called from the I/O thread.
+ * @param[in] type The type of input from #SOC_INPUT.
+ * @param[in] data The start of a line of input within a larger buffer.
+ * @param[in] length The number of bytes within the line.
+ * @retval void
+ */
+const void SocketClient::aInput( const uint_t& type, const char* data, const uint_t& length )
+{
+    m_input_queue.Push( pair<uint_t,string>( type, string( data, length ) ) );
+
+    return;
+}
+
 /**
  * @brief Associates an Account object to the SocketClient.
  * @param[in] account A pointer to the Account object to be associated.
@@ -684,6 +1195,60 @@ const bool SocketClient::sAccount( Account* account )
     return true;
 }
 
+/**
+ * @brief Start or end compressing output to the client. Called from the I/O thread.
+ * @param[in] val True to start compressing output, false to end the compression stream.
+ * @param[out] output The string to append the end of the compression stream to.
+ * @retval false Returned if the compression stream was unable to be started.
+ * @retval true Returned if output is now compressed or uncompressed as requested.
+ */
+const bool SocketClient::sCompress( const bool& val, string& output )
+{
+    UFLAGS_DE( flags );
+    static z_stream zs_zero;
+
+    if ( val == ( m_deflate != NULL ) )
+        return true;
+
+    if ( val )
+    {
+        m_deflate = new z_stream;
+        *m_deflate = zs_zero;
+
+        if ( ::deflateInit2( m_deflate, CFG_SOC_COMPRESS_LEVEL, Z_DEFLATED, MAX_WBITS, CFG_SOC_COMPRESS_MEMLEVEL, Z_DEFAULT_STRATEGY ) != Z_OK )
+        {
+            LOGFMT( flags, "SocketClient::sCompress()->deflateInit2()-> descriptor %ld returned error: %s", gDescriptor(), m_deflate->msg != NULL ? m_deflate->msg : "unknown" );
+            delete m_deflate;
+            m_deflate = NULL;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Finishing the stream tells the client that uncompressed output follows
+    if ( !Deflate( NULL, 0, Z_FINISH, output ) )
+        LOGFMT( flags, "SocketClient::sCompress()->SocketClient::Deflate()-> descriptor %ld returned false", gDescriptor() );
+
+    ::deflateEnd( m_deflate );
+    delete m_deflate;
+    m_deflate = NULL;
+
+    return true;
+}
+
+/**
+ * @brief Sets whether the connection has failed or been closed. Called from the I/O thread.
+ * @param[in] val True once the connection is no longer usable.
+ * @retval void
+ */
+const void SocketClient::sHangup( const bool& val )
+{
+    m_hangup = val;
+
+    return;
+}
+
 /**
  * @brief Set the idle timer value of the socket.
  * @param[in] idle A #uint_t value ranging from 0 to #CFG_SOC_MAX_IDLE.
@@ -700,7 +1265,7 @@ const bool SocketClient::sIdle( const uint_t& idle )
         return false;
     }
 
-    m_idle = idle;
+    m_last_input = static_cast<sint_t>( g_global->m_pulse ) - static_cast<sint_t>( idle );
 
     return true;
 }
@@ -728,42 +1293,22 @@ const bool SocketClient::sLogin( const uint_t& key, const string& val )
 }
 
 /**
- * @brief Resolve the hostname of the client. Threaded to avoid locking on long resolutions.
- * @param[in] data A self-reference passed via this to use for callback.
+ * @brief Sets whether the client is queued within socket_client_output_list to be visited on the next pulse.
+ * @param[in] val True to queue the client, false to have it passed over when the queue is next visited.
  * @retval void
  */
-void* SocketClient::tResolveHostname( void* data )
+const void SocketClient::sOutputPending( const bool& val )
 {
-    UFLAGS_DE( flags );
-    SocketClient* socket_client = reinterpret_cast<SocketClient*>( data );
-    static sockaddr_in6 sa_zero;
-    sockaddr_in6 sa = sa_zero;
-    sint_t error = 0;
-    char hostname[CFG_STR_MAX_BUFLEN];
+    if ( val == m_output_pending )
+        return;
 
-    sa.sin6_family = AF_INET;
+    // Clearing leaves the handle queued; Server::PollSockets() skips any client which is no longer pending or no longer exists
+    if ( val )
+        socket_client_output_list.push_back( m_list_handle );
 
-    if ( ( error = ::inet_pton( AF_INET6, CSTR( socket_client->gHostname() ), &sa.sin6_addr ) ) != 1 )
-    {
-        LOGFMT( flags, "SocketClient::tResolveHostname()->inet_pton()-> returned errno %d: %s", error, gai_strerror( error ) );
-        ::pthread_exit( reinterpret_cast<void*>( EXIT_FAILURE ) );
-    }
+    m_output_pending = val;
 
-    if ( ( error = ::getnameinfo( reinterpret_cast<sockaddr*>( &sa ), sizeof( sa ), hostname, sizeof( hostname ), NULL, 0, 0 ) ) != 0 )
-    {
-        LOGFMT( flags, "SocketClient::tResolveHostname()->getnameinfo()-> returned errno %d: %s", error, gai_strerror( error ) );
-        ::pthread_exit( reinterpret_cast<void*>( EXIT_FAILURE ) );
-    }
-
-    if ( !socket_client->sHostname( hostname ) )
-    {
-        LOGFMT( flags, "SocketClient::tResolveHostname()->SocketClient::sHostname()-> hostname %s returned false", hostname );
-        ::pthread_exit( reinterpret_cast<void*>( EXIT_FAILURE ) );
-    }
-
-    LOGFMT( 0, "SocketClient::ResolveHostname()-> %s", CSTR( socket_client->gHostname() ) );
-
-    ::pthread_exit( reinterpret_cast<void*>( EXIT_SUCCESS ) );
+    return;
 }
 
 /**
@@ -787,6 +1332,32 @@ const bool SocketClient::sState( const uint_t& state )
     return true;
 }
 
+/**
+ * @brief Save the telnet parser state so that a sequence split across reads is resumed by the next one. Called from the I/O thread.
+ * @param[in] state A #uint_t value from #SOC_TELNET.
+ * @param[in] cmd The telnet command awaiting its option byte, if any.
+ * @retval void
+ */
+const void SocketClient::sTelnetState( const uint_t& state, const char& cmd )
+{
+    m_telnet_state = state;
+    m_telnet_cmd = cmd;
+
+    return;
+}
+
+/**
+ * @brief Sets whether the socket is able to accept more data.
+ * @param[in] val False once a write would block, true once the reactor reports the socket writable again.
+ * @retval void
+ */
+const void SocketClient::sWritable( const bool& val )
+{
+    m_writable = val;
+
+    return;
+}
+
 /* Internal */
 /**
  * @brief Constructor for the SocketClient::TermInfo class.
@@ -820,15 +1391,39 @@ SocketClient::SocketClient()
     uint_t i = uintmin_t;
 
     m_account = NULL;
+    m_closing = false;
+    m_command_preempt = 0;
     m_command_queue.clear();
-    m_idle = 0;
+    m_command_refill = g_global->m_pulse;
+    m_command_tokens = CFG_SOC_INPUT_COMMAND_BURST * CFG_GAM_PULSE_RATE;
+    m_commands_run = 0;
+    m_deflate = NULL;
+    m_events.clear();
+    m_hangup = false;
     m_input.clear();
+    m_input_limited = false;
+    m_input_overflow = false;
+    m_input_refill = chrono::steady_clock::now();
+    m_input_tokens = CFG_SOC_INPUT_BYTE_BURST;
+    m_io_thread = NULL;
+    m_last_command = uintmax_t;
+    m_last_input = static_cast<sint_t>( g_global->m_pulse );
+    m_list_handle = 0;
     for ( i = 0; i < MAX_SOC_LOGIN; i++ )
         m_login[i].clear();
     m_output.clear();
+    m_output_chain.clear();
+    m_output_pending = false;
     m_quitting = false;
     m_state = SOC_STATE_DISCONNECTED;
+    m_telnet_cmd = 0;
+    m_telnet_state = SOC_TELNET_DATA;
     m_terminfo = new SocketClient::TermInfo();
+    m_throttled = false;
+    m_writable = true;
+    m_write_buffer.clear();
+    m_write_offset = 0;
+    m_write_size = 0;
 
     return;
 }
@@ -838,6 +1433,12 @@ SocketClient::SocketClient()
  */
 SocketClient::~SocketClient()
 {
+    if ( m_deflate != NULL )
+    {
+        ::deflateEnd( m_deflate );
+        delete m_deflate;
+    }
+
     delete m_terminfo;
 
     return;
@@ -26,20 +26,19 @@
 #include "h/socketserver.h"
 
 #include "h/list.h"
+#include "h/reactor.h"
 #include "h/socketclient.h"
 
 /* Core */
 /**
- * @brief Accept a new connection on the listening port.
+ * @brief Accept every connection waiting on the listening port, up to #CFG_SOC_MAX_ACCEPT per pulse.
  * @retval void
  */
 const void SocketServer::Accept()
 {
     UFLAGS_DE( flags );
     sint_t descriptor = 0;
-    sockaddr_storage sin;
-    socklen_t size = static_cast<socklen_t>( sizeof( sin ) );
-    SocketClient* socket_client;
+    SocketClient* socket_client = NULL;
 
     if ( !Valid() )
     {
@@ -47,27 +46,45 @@ const void SocketServer::Accept()
         return;
     }
 
-    if ( ::getsockname( gDescriptor(), reinterpret_cast<sockaddr*>( &sin ), &size ) < 0 )
+    // Each pulse brings a fresh budget
+    if ( m_accept_pulse != g_global->m_pulse )
     {
-        LOGERRNO( flags, "SocketServer::Accept()->getsockname()->" );
-        return;
+        m_accept_pulse = g_global->m_pulse;
+        m_accepted = 0;
     }
 
-    if ( ( descriptor = ::accept( gDescriptor(), reinterpret_cast<sockaddr*>( &sin ), &size ) ) < 0 )
+    while ( m_accepted < CFG_SOC_MAX_ACCEPT )
     {
-        LOGERRNO( flags, "SocketServer::Accept()->accept()->" );
-        return;
-    }
+        // Close-on-exec keeps client sockets out of plugin builds; a reboot clears it on the sockets it hands over
+        if ( ( descriptor = ::accept4( gDescriptor(), NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC ) ) < 0 )
+        {
+            // The backlog has been drained
+            if ( errno == EAGAIN || errno == EWOULDBLOCK )
+                return;
 
-    socket_client = new SocketClient();
+            // The pending connection was reset before it could be accepted
+            if ( errno == EINTR || errno == ECONNABORTED || errno == EPROTO )
+                continue;
 
-    if ( !socket_client->New( descriptor ) )
-    {
-        LOGSTR( flags, "SocketServer::Accept()->SocketClient::New()-> returned false" );
-        socket_client->Delete();
-        return;
+            // Most likely out of descriptors; try again next pulse rather than spinning on the backlog
+            LOGERRNO( flags, "SocketServer::Accept()->accept4()->" );
+            break;
+        }
+
+        m_accepted++;
+        socket_client = new SocketClient();
+
+        if ( !socket_client->New( descriptor ) )
+        {
+            LOGSTR( flags, "SocketServer::Accept()->SocketClient::New()-> returned false" );
+            socket_client->Delete();
+        }
     }
 
+    // Level-triggered readiness would report the remaining backlog immediately, so stop watching until the next pulse
+    if ( !sPaused( true ) )
+        LOGSTR( flags, "SocketServer::Accept()->SocketServer::sPaused()-> returned false" );
+
     return;
 }
 
@@ -107,6 +124,13 @@ const bool SocketServer::Bind( const uint_t& port, const string& addr )
         return false;
     }
 
+    // Every socket sharing the port must set this before binding, including the first
+    if ( CFG_SOC_LISTENERS > 1 && ::setsockopt( gDescriptor(), SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>( &enable ), sizeof( enable ) ) < 0 )
+    {
+        LOGERRNO( flags, "SocketServer::Bind()->setsockopt()->" );
+        return false;
+    }
+
     if ( ::bind( gDescriptor(), reinterpret_cast<sockaddr*>( &sa ), sizeof( sa ) ) < 0 )
     {
         LOGERRNO( flags, "SocketServer::Bind()->bind()->" );
@@ -127,6 +151,9 @@ const void SocketServer::Delete()
     if ( !Valid() )
         return;
 
+    if ( g_global->m_reactor != NULL && !g_global->m_reactor->Remove( this ) )
+        LOGFMT( flags, "SocketServer::Delete()->Reactor::Remove()-> descriptor %ld returned false", gDescriptor() );
+
     if ( !g_global->m_shutdown && !g_stats->sSocketClose( g_stats->gSocketClose() + 1 ) )
         LOGFMT( flags, "SocketServer::Delete()->Server::Stats::sSocketClose()-> value %lu returned false", g_stats->gSocketClose() + 1 );
 
@@ -178,22 +205,36 @@ const bool SocketServer::New( const sint_t& descriptor, const bool& reboot )
         if ( !Bind( g_global->m_port, CFG_SOC_BIND_ADDR ) )
         {
             LOGSTR( flags, "SocketServer::New()->SocketServer::Bind()-> returned false" );
-            Server::Shutdown( EXIT_FAILURE );
+            return false;
         }
 
         if ( !sHostname( Server::gHostname() ) )
         {
             LOGFMT( flags, "SocketServer::New()->SocketServer::sHostname()-> hostname %s returned false", CSTR( Server::gHostname() ) );
-            Server::Shutdown( EXIT_FAILURE );
+            return false;
         }
 
         if ( !Listen() )
         {
             LOGSTR( flags, "SocketServer::New()->SocketServer::Listen()-> returned false" );
-            Server::Shutdown( EXIT_FAILURE );
+            return false;
         }
     }
 
+    // Never block the game loop in accept() if a pending connection disappears before it is serviced
+    if ( ::fcntl( gDescriptor(), F_SETFL, O_NONBLOCK ) < 0 )
+    {
+        LOGERRNO( flags, "SocketServer::New()->fcntl()->" );
+        return false;
+    }
+
+    // Level-triggered so that any connections left in the backlog are reported again on the next pulse
+    if ( !g_global->m_reactor->Add( this, EPOLLIN ) )
+    {
+        LOGSTR( flags, "SocketServer::New()->Reactor::Add()-> returned false" );
+        return false;
+    }
+
     g_stats->sSocketOpen( g_stats->gSocketOpen() + 1 );
 
     return true;
@@ -210,8 +251,40 @@ const string SocketServer::Serialize() const
 }
 
 /* Query */
+/**
+ * @brief Returns if the listening socket has been taken out of the Reactor until the next pulse.
+ * @retval false Returned if new connections are being accepted.
+ * @retval true Returned if the accept budget for this pulse was spent.
+ */
+const bool SocketServer::gPaused() const
+{
+    return m_paused;
+}
 
 /* Manipulate */
+/**
+ * @brief Stop or resume watching the listening socket for new connections. Connections arriving while paused wait in the backlog.
+ * @param[in] val True to stop watching, false to resume.
+ * @retval false Returned if the Reactor was unable to be updated.
+ * @retval true Returned if the listening socket is now paused or resumed as requested.
+ */
+const bool SocketServer::sPaused( const bool& val )
+{
+    UFLAGS_DE( flags );
+
+    if ( m_paused == val )
+        return true;
+
+    if ( !g_global->m_reactor->Modify( this, val ? 0 : EPOLLIN ) )
+    {
+        LOGFMT( flags, "SocketServer::sPaused()->Reactor::Modify()-> descriptor %ld returned false", gDescriptor() );
+        return false;
+    }
+
+    m_paused = val;
+
+    return true;
+}
 
 /* Internal */
 /**
@@ -219,6 +292,10 @@ const string SocketServer::Serialize() const
  */
 SocketServer::SocketServer()
 {
+    m_accept_pulse = 0;
+    m_accepted = 0;
+    m_paused = false;
+
     return;
 }
 
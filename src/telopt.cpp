@@ -26,6 +26,16 @@
 
 #include "h/socketclient.h"
 
+/**
+ * @brief Marks the end of compressed output within a client's output. Never sent itself; recognized by identity rather than content.
+ */
+const Segment Telopt::opt_compress_end = make_shared<const string>();
+
+/**
+ * @brief Begins compressed output: the I/O thread sends this segment as is, then compresses everything after it.
+ */
+const Segment Telopt::opt_compress_start = make_shared<const string>( string( { (char)IAC, (char)SB, (char)TELOPT_COMPRESS2, (char)IAC, (char)SE } ) );
+
 /* Core */
 /**
  * @brief Send initial options to negotiate for, then the login string.
@@ -47,6 +57,9 @@ const bool Telopt::InitialNegotiation( SocketClient* client )
     Telopt::Negotiate( client, SOC_TELOPT_ECHO, false );
     Telopt::Negotiate( client, SOC_TELOPT_MSP, false );
 
+    // Compression is only started if the client agrees to it
+    Telopt::Send( client, (char)WILL, (char)TELOPT_COMPRESS2 );
+
     if ( !client->Send( CFG_STR_LOGIN ) )
     {
         LOGSTR( flags, "Telopt::InitialNegotiation()-> SocketClient::Send()-> returned false" );
@@ -57,86 +70,129 @@ const bool Telopt::InitialNegotiation( SocketClient* client )
 }
 
 /**
- * @brief Processes data received from a SocketClient for telnet sequences.
+ * @brief Processes data received from a SocketClient for telnet sequences. Called from the I/O thread.
+ * Plain data between IACs is copied in whole runs, and the parser state is kept by the client so that a sequence
+ * split across reads is completed by the next one.
  * @param[in] client The SocketClient to process data for.
  * @param[in] data The received data to be processed.
- * retval string A string that has been processed for telnet sequences.
+ * @param[in] length The number of bytes within data.
+ * @param[out] output The string to append data that isn't part of a telnet sequence to.
+ * @retval void
  */
-const string Telopt::ProcessInput( SocketClient* client, const string& data )
+const void Telopt::ProcessInput( SocketClient* client, const char* data, const uint_t& length, string& output )
 {
     UFLAGS_DE( flags );
-    uint_t i = uintmin_t, o = uintmin_t;
-    char output[CFG_STR_MAX_BUFLEN] = {'\0'};
+    const char* pos = data;
+    const char* end = data + length;
+    const char* iac = NULL;
+    uint_t state = uintmin_t;
+    char cmd = 0;
 
     if ( client == NULL )
     {
         LOGSTR( flags, "Telopt::ProcessInput()-> called with NULL client" );
-        return output;
+        return;
     }
 
-    if ( data.empty() )
-        return output;
+    if ( data == NULL || length == 0 )
+        return;
 
-    if ( data.length() >= CFG_STR_MAX_BUFLEN )
-        LOGFMT( flags, "Telopt::ProcessInput()-> data length of %lu exceeds buffer length of %lu, truncating", data.length(), CFG_STR_MAX_BUFLEN );
+    state = client->gTelnetState();
+    cmd = client->gTelnetCommand();
 
-    for ( i = 0; i < data.length() && i < CFG_STR_MAX_BUFLEN; i++ )
+    while ( pos < end )
     {
-        if ( data[i] == (char)IAC )
+        switch ( state )
         {
-            switch ( data[i+1] )
-            {
-                case (char)IAC: // IAC IAC will result in IAC being passed as data
-                    output[o++] = (char)IAC;
-                    i++;
-                break;
-
-                case (char)DO:
-                case (char)DONT:
-                case (char)WILL:
-                case (char)WONT:
-                    Handshake( client, data[i+1], data[i+2] );
-                    i += 2; // data[i] == IAC, data[i+1] = cmd, data[i+2] = opt
-                break;
-            }
+            case SOC_TELNET_DATA:
+                // Copy everything up to the next IAC at once; memchr() is vectorized by the C library
+                if ( ( iac = static_cast<const char*>( ::memchr( pos, IAC, end - pos ) ) ) == NULL )
+                {
+                    output.append( pos, end - pos );
+                    pos = end;
+                    break;
+                }
+
+                output.append( pos, iac - pos );
+                pos = iac + 1;
+                state = SOC_TELNET_IAC;
+            break;
+
+            case SOC_TELNET_IAC:
+                switch ( *pos )
+                {
+                    case (char)IAC: // IAC IAC will result in IAC being passed as data
+                        output += (char)IAC;
+                        state = SOC_TELNET_DATA;
+                    break;
+
+                    case (char)DO:
+                    case (char)DONT:
+                    case (char)WILL:
+                    case (char)WONT:
+                        cmd = *pos;
+                        state = SOC_TELNET_OPTION;
+                    break;
+
+                    case (char)SB:
+                        state = SOC_TELNET_SB;
+                    break;
+
+                    default: // Commands without an option, such as NOP or GA, are ignored
+                        state = SOC_TELNET_DATA;
+                    break;
+                }
+
+                pos++;
+            break;
+
+            case SOC_TELNET_OPTION:
+                // Negotiation depends on game state, so the reply is left to the game thread
+                client->aInput( SOC_INPUT_TELOPT, string( 1, cmd ) + *pos );
+                cmd = 0;
+                pos++;
+                state = SOC_TELNET_DATA;
+            break;
+
+            case SOC_TELNET_SB:
+                // No subnegotiations are supported, so skip ahead to the IAC SE which ends this one
+                if ( ( iac = static_cast<const char*>( ::memchr( pos, IAC, end - pos ) ) ) == NULL )
+                {
+                    pos = end;
+                    break;
+                }
+
+                pos = iac + 1;
+                state = SOC_TELNET_SB_IAC;
+            break;
+
+            case SOC_TELNET_SB_IAC:
+                // Anything other than SE, such as an escaped IAC IAC, is part of the subnegotiation
+                state = ( *pos == (char)SE ) ? SOC_TELNET_DATA : SOC_TELNET_SB;
+                pos++;
+            break;
+
+            default:
+                LOGFMT( flags, "Telopt::ProcessInput()-> descriptor %ld in invalid state: %lu", client->gDescriptor(), state );
+                state = SOC_TELNET_DATA;
+            break;
         }
-        else
-            output[o++] = data[i];
     }
 
-    return output;
+    client->sTelnetState( state, cmd );
+
+    return;
 }
 
 /**
- * @brief Processes data to be sent to a SocketClient for telnet sequences.
- * @param[in] client The SocketClient to process data for.
- * @param[in] data The received data to be processed.
+ * @brief Processes data to be sent to a SocketClient for telnet sequences. The result doesn't depend on which client it
+ * is sent to, so a message processed once may be shared as a #Segment by any number of clients.
+ * @param[in] data The data to be processed.
  * @retval string A string that has been processed for telnet sequences.
  */
-const string Telopt::ProcessOutput( SocketClient* client, const string& data )
+const string Telopt::ProcessOutput( const string& data )
 {
-    UFLAGS_DE( flags );
-    uint_t i = uintmin_t, o = uintmin_t;
-    char output[CFG_STR_MAX_BUFLEN] = {'\0'};
-
-    if ( client == NULL )
-    {
-        LOGSTR( flags, "Telopt::ProcessOutput()-> called with NULL client" );
-        return output;
-    }
-
-    if ( data.empty() )
-        return output;
-
-    if ( data.length() >= CFG_STR_MAX_BUFLEN )
-        LOGFMT( flags, "Telopt::ProcessOutput()-> data length of %lu exceeds buffer length of %lu, truncating", data.length(), CFG_STR_MAX_BUFLEN );
-
-    for ( i = 0; i < data.length() && i < CFG_STR_MAX_BUFLEN; i++ )
-    {
-        output[o++] = data[i];
-    }
-
-    return output;
+    return data;
 }
 
 /* Query */
@@ -183,6 +239,21 @@ const void Telopt::Handshake( SocketClient* client, const char& cmd, const char&
                 Telopt::Send( client, (char)DONT, opt );
         break;
 
+        case (char)TELOPT_COMPRESS2:
+            if ( cmd == (char)DO )
+            {
+                Negotiate( client, SOC_TELOPT_COMPRESS2, true, true );
+                client->gTermInfo()->sTelopt( SOC_TELOPT_COMPRESS2, true );
+            }
+            else if ( cmd == (char)DONT )
+            {
+                Negotiate( client, SOC_TELOPT_COMPRESS2, false, client->gTermInfo()->gTelopt( SOC_TELOPT_COMPRESS2 ) );
+                client->gTermInfo()->sTelopt( SOC_TELOPT_COMPRESS2, false );
+            }
+            else if ( cmd == (char)WILL )
+                Telopt::Send( client, (char)DONT, opt );
+        break;
+
         case (char)TELOPT_MSP:
             if ( cmd == (char)DO )
             {
@@ -292,6 +363,11 @@ const void Telopt::Negotiate( SocketClient* client, const uint_t& opt, const boo
                     Telopt::Send( client, val ? WILL : WONT, TELOPT_MSP );
                 break;
 
+                case SOC_TELOPT_COMPRESS2:
+                    // Rather than a reply, the I/O thread starts or ends the client's compression stream at this point in its output
+                    client->Send( val ? opt_compress_start : opt_compress_end );
+                break;
+
                 default:
                 break;
             }
@@ -24,8 +24,10 @@
 #include "h/includes.h"
 #include "h/thing.h"
 
+#include "h/atomtable.h"
 #include "h/brain.h"
 #include "h/exit.h"
+#include "h/server.h"
 
 /* Core */
 /**
@@ -54,7 +56,102 @@ const bool Thing::AddThing( Thing* thing )
         return false;
     }
 
-    m_contents.push_back( thing );
+    // Append so the contents stay in the order they arrived, which is the order they are shown in
+    thing->m_sibling_prev = m_contents_tail;
+    thing->m_sibling_next = NULL;
+
+    if ( m_contents_tail != NULL )
+        m_contents_tail->m_sibling_next = thing;
+    else
+        m_contents_head = thing;
+
+    m_contents_tail = thing;
+    m_contents_count++;
+    thing->m_order = ++m_contents_added;
+    AddKeywords( thing );
+
+    return true;
+}
+
+/**
+ * @brief Looks up a Thing by its exact id within an index.
+ * @param[in] id The id of the Thing to search for.
+ * @param[in] index The index to be searched.
+ * @retval Thing* A pointer to the Thing registered under id, or NULL if one is not found.
+ */
+Thing* Thing::Find( const string& id, const ThingIndex& index )
+{
+    ThingIndex::const_iterator ti;
+
+    if ( ( ti = index.find( id ) ) == index.end() )
+        return NULL;
+
+    return ti->second;
+}
+
+/**
+ * @brief Locates a Thing within the contents of this Thing by any word of its name, without walking the contents.
+ * @param[in] name The word, or the start of a word, to search for.
+ * @param[in] type The type of Thing to search for, from #THING_TYPE.
+ * @param[in] ignore A Thing which should never be returned, if any.
+ * @retval Thing* A pointer to the earliest arrival whose name has a word beginning with name, or NULL if one is not found.
+ */
+Thing* Thing::FindContent( const string& name, const uint_t& type, const Thing* ignore ) const
+{
+    multimap<string,Thing*>::const_iterator mi;
+    Thing* thing = NULL;
+    string key( name );
+
+    if ( name.empty() || type >= MAX_THING_TYPE || m_keywords == NULL )
+        return thing;
+
+    if ( CFG_GAM_CMD_IGNORE_CASE )
+        key = Utils::Lower( key );
+
+    // Every keyword that begins with key sorts together, so only the matches themselves are visited
+    for ( mi = m_keywords[type].lower_bound( key ); mi != m_keywords[type].end() && mi->first.compare( 0, key.length(), key ) == 0; mi++ )
+    {
+        if ( mi->second == ignore )
+            continue;
+
+        // Keep the same answer a walk of the contents would have given
+        if ( thing == NULL || mi->second->m_order < thing->m_order )
+            thing = mi->second;
+    }
+
+    return thing;
+}
+
+/**
+ * @brief Registers this Thing within an index under its id. A Thing may only be held within one index at a time, and a Thing
+ * without an id is keyed once one is set.
+ * @param[in] index A pointer to the index this Thing should be registered within.
+ * @retval false Returned if index is NULL or another Thing is already registered under the same id.
+ * @retval true Returned if this Thing was registered within index.
+ */
+const bool Thing::Index( ThingIndex* index )
+{
+    UFLAGS_DE( flags );
+
+    if ( index == NULL )
+    {
+        LOGSTR( flags, "Thing::Index()-> called with NULL index" );
+        return false;
+    }
+
+    Unindex();
+    m_index = index;
+
+    // A Thing still being created has no id yet; it will be keyed once Thing::sId() is called
+    if ( m_id.empty() )
+        return true;
+
+    if ( !index->insert( pair<string,Thing*>( m_id, this ) ).second )
+    {
+        LOGFMT( flags, "Thing::Index()-> id %s is already registered", CSTR( m_id ) );
+        m_index = NULL;
+        return false;
+    }
 
     return true;
 }
@@ -123,14 +220,26 @@ const bool Thing::RemoveThing( Thing* thing )
 
     /** @todo Logic to check debuffs, restrictions, etc. */
 
-    if ( find ( m_contents.begin(), m_contents.end(), thing ) != m_contents.end() )
-    {
-        m_contents.erase( find( m_contents.begin(), m_contents.end(), thing ) );
-        thing->m_container = NULL;
-        return true;
-    }
+    if ( thing->m_container != this )
+        return false;
+
+    if ( thing->m_sibling_prev != NULL )
+        thing->m_sibling_prev->m_sibling_next = thing->m_sibling_next;
+    else
+        m_contents_head = thing->m_sibling_next;
 
-    return false;
+    if ( thing->m_sibling_next != NULL )
+        thing->m_sibling_next->m_sibling_prev = thing->m_sibling_prev;
+    else
+        m_contents_tail = thing->m_sibling_prev;
+
+    m_contents_count--;
+    RemoveKeywords( thing );
+    thing->m_container = NULL;
+    thing->m_sibling_next = NULL;
+    thing->m_sibling_prev = NULL;
+
+    return true;
 }
 
 /**
@@ -143,8 +252,6 @@ const bool Thing::RemoveThing( Thing* thing )
 const void Thing::Send( const string& msg, Thing* speaker, Thing* target ) const
 {
     UFLAGS_DE( flags );
-    CITER( vector, Thing*, ti );
-    Thing* thing = NULL;
 
     if ( msg.empty() )
     {
@@ -152,9 +259,34 @@ const void Thing::Send( const string& msg, Thing* speaker, Thing* target ) const
         return;
     }
 
-    for ( ti = m_contents.begin(); ti != m_contents.end(); ti++ )
+    // Processed once and shared by every recipient
+    Send( make_shared<const string>( Telopt::ProcessOutput( msg ) ), speaker, target );
+
+    return;
+}
+
+/**
+ * @brief Send a shared segment to all Thing objects within the Thing except for the speaker.
+ * @param[in] msg The segment to be sent, as already processed by Telopt::ProcessOutput().
+ * @param[in] speaker The Thing originating the message.
+ * @param[in] target The Thing who is the target of the message.
+ * @retval void
+ */
+const void Thing::Send( const Segment& msg, Thing* speaker, Thing* target ) const
+{
+    UFLAGS_DE( flags );
+    Thing* thing = NULL;
+    Thing* next = NULL;
+
+    if ( !msg || msg->empty() )
     {
-        thing = *ti;
+        LOGSTR( flags, "Thing::Send()-> called with empty msg" );
+        return;
+    }
+
+    for ( thing = m_contents_head; thing != NULL; thing = next )
+    {
+        next = thing->m_sibling_next;
 
         if ( thing == speaker || thing == target )
             continue;
@@ -186,12 +318,12 @@ Thing* Thing::gContainer() const
 }
 
 /**
- * @brief Returns the contents of this Thing.
- * @retval vector<Thing*> The contents of this Thing.
+ * @brief Returns the number of Things contained within this Thing.
+ * @retval uint_t The number of Things contained within this Thing.
  */
-const vector<Thing*> Thing::gContents() const
+const uint_t Thing::gContentCount() const
 {
-    return m_contents;
+    return m_contents_count;
 }
 
 /**
@@ -212,6 +344,25 @@ const string Thing::gDescription( const uint_t& type ) const
     return m_description[type];
 }
 
+/**
+ * @brief Returns the earliest arrival of the Things contained within this Thing, to begin walking the contents in the order they arrived.
+ * @retval Thing* A pointer to the first Thing contained within this Thing, or NULL if there are none.
+ */
+Thing* Thing::gFirstContent() const
+{
+    return m_contents_head;
+}
+
+/**
+ * @brief Returns the name associated with this Thing, folded to lowercase if #CFG_GAM_CMD_IGNORE_CASE is set. The folded form is
+ * worked out once when the name is interned, so searches may compare against it freely.
+ * @retval string A string containing the folded name associated with this Thing.
+ */
+const string& Thing::gFoldedName() const
+{
+    return g_global->m_atom_table->gFoldedText( m_name );
+}
+
 /**
  * @brief Returns the id associated with this Thing.
  * @retval string A string containing the id associated with this Thing.
@@ -225,7 +376,16 @@ const string Thing::gId() const
  * @brief Returns the location id associated with this Thing.
  * @retval string A string containing the location id associated with this Thing.
  */
-const string Thing::gLocation() const
+const string& Thing::gLocation() const
+{
+    return g_global->m_atom_table->gText( m_location );
+}
+
+/**
+ * @brief Returns the Atom of the location id associated with this Thing.
+ * @retval Atom The Atom of the location id, which may be compared against another Atom directly.
+ */
+const Atom Thing::gLocationAtom() const
 {
     return m_location;
 }
@@ -234,11 +394,30 @@ const string Thing::gLocation() const
  * @brief Returns the name associated with this Thing.
  * @retval string A string containing the name associated with this Thing.
  */
-const string Thing::gName() const
+const string& Thing::gName() const
+{
+    return g_global->m_atom_table->gText( m_name );
+}
+
+/**
+ * @brief Returns the Atom of the name associated with this Thing.
+ * @retval Atom The Atom of the name, which may be compared against another Atom directly.
+ */
+const Atom Thing::gNameAtom() const
 {
     return m_name;
 }
 
+/**
+ * @brief Returns the Thing which arrived in the same container after this Thing. Fetch it before acting on this Thing if this Thing may
+ * leave its container during a walk.
+ * @retval Thing* A pointer to the next Thing within the same container, or NULL if this Thing is the last.
+ */
+Thing* Thing::gNextContent() const
+{
+    return m_sibling_next;
+}
+
 /**
  * @brief Returns the inherited sub-type of this Thing.
  * @retval uint_t A value from #THING_TYPE.
@@ -252,7 +431,16 @@ const uint_t Thing::gType() const
  * @brief Returns the zone associated with this Thing.
  * @retval string A value containing the zone associated with this Thing.
  */
-const string Thing::gZone() const
+const string& Thing::gZone() const
+{
+    return g_global->m_atom_table->gText( m_zone );
+}
+
+/**
+ * @brief Returns the Atom of the zone associated with this Thing. Two Things share a zone only if their zone atoms are equal.
+ * @retval Atom The Atom of the zone.
+ */
+const Atom Thing::gZoneAtom() const
 {
     return m_zone;
 }
@@ -301,6 +489,26 @@ const bool Thing::sDescription( const string& description, const uint_t& type )
     return true;
 }
 
+/**
+ * @brief Removes this Thing from the index it is registered within, if any.
+ * @retval void
+ */
+const void Thing::Unindex()
+{
+    ThingIndex::iterator ti;
+
+    if ( m_index == NULL )
+        return;
+
+    // Never remove another Thing that happens to share the same id
+    if ( ( ti = m_index->find( m_id ) ) != m_index->end() && ti->second == this )
+        m_index->erase( ti );
+
+    m_index = NULL;
+
+    return;
+}
+
 /**
  * @brief Sets the id of this Thing.
  * @param[in] id A string containing the id this Thing should be set to.
@@ -310,6 +518,7 @@ const bool Thing::sDescription( const string& description, const uint_t& type )
 const bool Thing::sId( const string& id )
 {
     UFLAGS_DE( flags );
+    ThingIndex* index = m_index;
 
     if ( id.length() < CFG_THG_ID_MIN_LEN || id.length() > CFG_THG_ID_MAX_LEN )
     {
@@ -317,8 +526,13 @@ const bool Thing::sId( const string& id )
         return false;
     }
 
+    // Re-register under the new id so lookups never find a stale key
+    Unindex();
     m_id = id;
 
+    if ( index != NULL )
+        Index( index );
+
     return true;
 }
 
@@ -330,7 +544,7 @@ const bool Thing::sId( const string& id )
  */
 const bool Thing::sLocation( const string& location )
 {
-    m_location = location;
+    m_location = g_global->m_atom_table->Intern( location );
 
     return true;
 }
@@ -352,8 +566,34 @@ const bool Thing::sName( const string& name, const bool& system )
         return false;
     }
 
+    // The name is keyed within the container, so it has to be taken out under the old name and put back under the new
+    if ( m_container != NULL )
+        m_container->RemoveKeywords( this );
+
+    m_name = g_global->m_atom_table->Intern( name );
+
+    if ( m_container != NULL )
+        m_container->AddKeywords( this );
+
+    return true;
+}
+
+/**
+ * @brief Sets the name of this Thing to a name which has already been interned, such as that of a template being cloned.
+ * @param[in] name The Atom of the name this Thing should be set to.
+ * @retval false Returned if there was an error setting the name.
+ * @retval true Returned if the name was set successfully.
+ */
+const bool Thing::sName( const Atom& name )
+{
+    if ( m_container != NULL )
+        m_container->RemoveKeywords( this );
+
     m_name = name;
 
+    if ( m_container != NULL )
+        m_container->AddKeywords( this );
+
     return true;
 }
 
@@ -373,8 +613,14 @@ const bool Thing::sType( const uint_t& type )
         return false;
     }
 
+    if ( m_container != NULL )
+        m_container->RemoveKeywords( this );
+
     m_type = type;
 
+    if ( m_container != NULL )
+        m_container->AddKeywords( this );
+
     return true;
 }
 
@@ -385,6 +631,19 @@ const bool Thing::sType( const uint_t& type )
  * @retval true Returned if the zone was set successfully.
  */
 const bool Thing::sZone( const string& zone )
+{
+    m_zone = g_global->m_atom_table->Intern( zone );
+
+    return true;
+}
+
+/**
+ * @brief Sets the zone of this Thing to a zone which has already been interned.
+ * @param[in] zone The Atom of the zone this Thing should be set to.
+ * @retval false Returned if there was an error setting the zone.
+ * @retval true Returned if the zone was set successfully.
+ */
+const bool Thing::sZone( const Atom& zone )
 {
     m_zone = zone;
 
@@ -393,19 +652,93 @@ const bool Thing::sZone( const string& zone )
 
 /* Internal */
 /**
- * @brief Generates a new unique id for this Thing.
- * @param[in] seed Typically the size of the owning list, such as object_list.
+ * @brief Keys each word of the name of a Thing within this Thing's contents.
+ * @param[in] thing A pointer to a Thing within the contents of this Thing.
  * @retval void
  */
-const void Thing::NewId( const uint_t& seed )
+const void Thing::AddKeywords( Thing* thing )
 {
-    string input;
+    vector<string> words = Utils::StrTokens( thing->gFoldedName(), true );
+    ITER( vector, string, si );
 
-    input += seed;
-    input += m_name;
-    input += chrono::duration_cast<chrono::milliseconds>( g_global->m_time_current.time_since_epoch() ).count();
+    // Most Things never contain anything, so the index is only built once something arrives
+    if ( m_keywords == NULL )
+        m_keywords = new multimap<string,Thing*>[MAX_THING_TYPE];
 
-    m_id = ::crypt( CSTR( input ), CSTR( Utils::Salt( Utils::String( chrono::duration_cast<chrono::milliseconds>( g_global->m_time_current.time_since_epoch() ).count() ) ) ) );
+    for ( si = words.begin(); si != words.end(); si++ )
+        m_keywords[thing->m_type].insert( pair<string,Thing*>( *si, thing ) );
+
+    return;
+}
+
+/**
+ * @brief Generates a new unique id for this Thing. The id packs the milliseconds since #CFG_THG_ID_EPOCH into the top 42 bits,
+ * #CFG_THG_ID_NODE into the next 10, and a sequence number into the low 12, and is stored in base 36.
+ * @retval void
+ */
+const void Thing::NewId()
+{
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    static uint64_t last = 0, sequence = 0;
+    char buf[16];
+    uint64_t id = 0, now = 0;
+    uint_t pos = sizeof( buf );
+
+    now = chrono::duration_cast<chrono::milliseconds>( chrono::system_clock::now().time_since_epoch() ).count() - CFG_THG_ID_EPOCH;
+
+    // Never step backwards if the clock is adjusted; borrow the next millisecond once a sequence is used up
+    if ( now > last )
+    {
+        last = now;
+        sequence = 0;
+    }
+    else if ( ++sequence > 0xFFF )
+    {
+        last++;
+        sequence = 0;
+    }
+
+    id = ( last << 22 ) | ( ( CFG_THG_ID_NODE & 0x3FFULL ) << 12 ) | sequence;
+
+    do
+    {
+        buf[--pos] = digits[id % 36];
+        id /= 36;
+    } while ( id > 0 );
+
+    sId( string( buf + pos, sizeof( buf ) - pos ) );
+
+    return;
+}
+
+/**
+ * @brief Removes each word of the name of a Thing from the keywords of this Thing's contents.
+ * @param[in] thing A pointer to a Thing within the contents of this Thing.
+ * @retval void
+ */
+const void Thing::RemoveKeywords( Thing* thing )
+{
+    vector<string> words = Utils::StrTokens( thing->gFoldedName(), true );
+    ITER( vector, string, si );
+    pair<multimap<string,Thing*>::iterator,multimap<string,Thing*>::iterator> range;
+    multimap<string,Thing*>::iterator mi;
+
+    if ( m_keywords == NULL )
+        return;
+
+    for ( si = words.begin(); si != words.end(); si++ )
+    {
+        range = m_keywords[thing->m_type].equal_range( *si );
+
+        for ( mi = range.first; mi != range.second; mi++ )
+        {
+            if ( mi->second == thing )
+            {
+                m_keywords[thing->m_type].erase( mi );
+                break;
+            }
+        }
+    }
 
     return;
 }
@@ -419,14 +752,22 @@ Thing::Thing()
 
     m_brain = NULL;
     m_container = NULL;
-    m_contents.clear();
+    m_contents_added = 0;
+    m_contents_count = 0;
+    m_contents_head = NULL;
+    m_contents_tail = NULL;
     for ( i = 0; i < MAX_THING_DESCRIPTION; i++ )
         m_description[i].clear();
     m_id.clear();
-    m_location.clear();
-    m_name.clear();
+    m_index = NULL;
+    m_keywords = NULL;
+    m_location = ATOM_EMPTY;
+    m_name = ATOM_EMPTY;
+    m_order = 0;
+    m_sibling_next = NULL;
+    m_sibling_prev = NULL;
     m_type = THING_TYPE_THING;
-    m_zone.clear();
+    m_zone = ATOM_EMPTY;
 
     return;
 }
@@ -439,6 +780,8 @@ Thing::~Thing()
     if ( m_brain )
         m_brain->Delete();
 
+    Unindex();
+
     if ( !g_global->m_shutdown )
     {
         // To properly handle quit
@@ -446,5 +789,8 @@ Thing::~Thing()
            m_container->RemoveThing( this );
     }
 
+    if ( m_keywords != NULL )
+        delete[] m_keywords;
+
     return;
 }
@@ -249,36 +249,6 @@ const string Utils::Salt( const string& input )
     return output.str();
 }
 
-/**
- * @brief Returns a vector of strings split at linebreaks based on input.
- * @param[in] input A string to split on newline characters.
- * @retval vector<string> A vector of strings that were split on the linebreaks detected from input.
- */
-const vector<string> Utils::StrNewlines( const string& input )
-{
-    UFLAGS_DE( flags );
-
-    if ( input.empty() )
-    {
-        LOGSTR( flags, "Utils::StrNewlines()-> called with empty input" );
-        return vector<string>();
-    }
-
-    stringstream ss( input );
-    string line;
-    vector<string> output;
-
-    while ( getline( ss, line ) )
-    {
-        // Strip the newline off the end
-        line.resize( line.length() - 1 );
-        if ( !line.empty() )
-            output.push_back( line );
-    }
-
-    return output;
-}
-
 /**
  * @brief Returns if string s1 is a prefix of string s2.
  * @param[in] s1 The string to check against s2.
@@ -314,11 +284,13 @@ const bool Utils::StrPrefix( const string& s1, const string& s2, const bool& ign
 const string Utils::StrTime( const time_t& now )
 {
     UFLAGS_DE( flags );
+    char buf[CFG_STR_MAX_BUFLEN];
     string output;
 
-    if ( ( output = ::ctime( &now ) ).empty() )
+    // The reentrant form, as the I/O threads log alongside the game thread
+    if ( ::ctime_r( &now, buf ) == NULL || ( output = buf ).empty() )
     {
-        LOGSTR( flags, "Utils::StrTime()->ctime()-> returned NULL" );
+        LOGSTR( flags, "Utils::StrTime()->ctime_r()-> returned NULL" );
         return output;
     }
 
@@ -417,30 +389,6 @@ const bool Utils::iFile( const string& file )
     return true;
 }
 
-/**
- * @brief Determines if name exists within input where input is a space delimited string.
- * @param[in] name The value to search for within input.
- * @param[in] input The string of space delimited names to search within.
- * @retval false Returned if name does not exist within input.
- * @retval true Returned if name exists within input.
- */
-const bool Utils::iName( const string& name, const string& input )
-{
-    string names = input;
-
-    if ( CFG_GAM_CMD_IGNORE_CASE )
-        names = Utils::Lower( names );
-    while ( !names.empty() )
-    {
-        if ( CFG_GAM_CMD_IGNORE_CASE && Utils::Argument( names ).find( Utils::Lower( name ) ) == 0 )
-            return true;
-        else if ( Utils::Argument( names ).find( name ) == 0 )
-            return true;
-    }
-
-    return false;
-}
-
 /**
  * @brief Determines if a string is only a string of numerical values.
  * @param[in] input A string to check for numerical values.
@@ -905,8 +853,8 @@ const void Utils::_Logger( const uint_t& narg, const bitset<CFG_MEM_MAX_BITSET>&
     if ( output.empty() )
         return;
 
-    // prepend timestamp
-    pre = StrTime( chrono::high_resolution_clock::to_time_t( g_global->m_time_current ) );
+    // prepend timestamp; read from the clock directly, as the I/O threads log while the game thread updates Server::Global
+    pre = StrTime( chrono::system_clock::to_time_t( chrono::system_clock::now() ) );
     pre.append( " :: " );
 
     for ( i = 0; i < MAX_UTILS; i++ )